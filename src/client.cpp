@@ -69,15 +69,16 @@ Timeout::Timeout()
 {}
 Timeout::~Timeout() {}
 
-Channel::Channel(const std::shared_ptr<Context::Pvt>& context, const std::string& name, uint32_t cid)
+Channel::Channel(const std::shared_ptr<Context::Pvt>& context, ContextWorker* worker, const std::string& name, uint32_t cid)
     :context(context)
+    ,worker(worker)
     ,name(name)
     ,cid(cid)
 {}
 
 Channel::~Channel()
 {
-    context->chanByCID.erase(cid);
+    worker->chanByCID.erase(cid);
     // searchBuckets cleaned in tickSearch()
     if((state==Creating || state==Active) && conn && conn->bev) {
         {
@@ -125,7 +126,7 @@ void Channel::disconnect(const std::shared_ptr<Channel>& self)
 {
     self->state = Channel::Searching;
     self->sid = 0xdeadbeef; // spoil
-    context->searchBuckets[context->currentBucket].push_back(self);
+    worker->searchBuckets[worker->currentBucket].push_back(self);
 
     log_debug_printf(io, "Server %s detach channel '%s' to re-search\n",
                      conn ? conn->peerName.c_str() : "<disconnected>",
@@ -191,26 +192,38 @@ RequestInfo::RequestInfo(uint32_t sid, uint32_t ioid, std::shared_ptr<OperationB
     ,handle(handle)
 {}
 
-std::shared_ptr<Channel> Channel::build(const std::shared_ptr<Context::Pvt>& context, const std::string& name)
+std::shared_ptr<Channel> Channel::build(const std::shared_ptr<Context::Pvt>& context, ContextWorker* worker,
+                                        const std::string& name, const std::string& server)
 {
+    worker->loop.assertInLoop();
 
     std::shared_ptr<Channel> chan;
 
-    auto it = context->chanByName.find(name);
-    if(it!=context->chanByName.end()) {
+    // parse before any change.  throws for an invalid address.
+    SockAddr forced;
+    if(!server.empty())
+        forced = SockAddr(AF_INET, server.c_str(), context->effective.tcp_port);
+
+    auto key(std::make_pair(name, server));
+    auto it = worker->chanByName.find(key);
+    if(it!=worker->chanByName.end()) {
         chan = it->second;
         chan->garbage = false;
     }
 
     if(!chan) {
-        while(context->chanByCID.find(context->nextCID)!=context->chanByCID.end())
-            context->nextCID++;
+        // search replies are routed to the worker by CID
+        const auto nworkers = context->workers.size();
+        while(worker->nextCID%nworkers!=worker->index
+              || worker->chanByCID.find(worker->nextCID)!=worker->chanByCID.end())
+            worker->nextCID++;
 
-        chan = std::make_shared<Channel>(context, name, context->nextCID);
-        context->chanByCID[chan->cid] = chan;
-        context->chanByName[chan->name] = chan;
+        chan = std::make_shared<Channel>(context, worker, name, worker->nextCID);
+        chan->forcedServer = forced;
+        worker->chanByCID[chan->cid] = chan;
+        worker->chanByName[key] = chan;
 
-        context->searchBuckets[context->currentBucket].push_back(chan);
+        worker->searchBuckets[worker->currentBucket].push_back(chan);
 
         context->poke(true);
     }
@@ -276,16 +289,40 @@ void Context::hurryUp()
     });
 }
 
-void Context::cacheClear()
+Context::SearchStats Context::searchStats() const
 {
     if(!pvt)
         throw std::logic_error("NULL Context");
 
-    pvt->tcp_loop.call([this](){
-        // run twice to ensure both mark and sweep of all unused channels
-        pvt->cacheClean();
-        pvt->cacheClean();
+    SearchStats ret{};
+
+    for(auto& worker : pvt->workers) {
+        worker->loop.call([&worker, &ret](){
+            ret.txPackets += worker->searchTx.npacket;
+            ret.txSyscalls += worker->searchTx.nsyscall;
+        });
+    }
+
+    pvt->tcp_loop.call([this, &ret](){
+        ret.rxPackets = pvt->searchBatch.npacket;
+        ret.rxSyscalls = pvt->searchBatch.nsyscall;
     });
+
+    return ret;
+}
+
+void Context::cacheClear()
+{
+    if(!pvt)
+        throw std::logic_error("NULL Context");
+
+    for(auto& worker : pvt->workers) {
+        worker->loop.call([&worker](){
+            // run twice to ensure both mark and sweep of all unused channels
+            worker->cacheClean();
+            worker->cacheClean();
+        });
+    }
 }
 
 static
@@ -305,14 +342,22 @@ Context::Pvt::Pvt(const Config& conf)
     ,searchTx(AF_INET, SOCK_DGRAM, 0)
     ,tcp_loop("PVXCTCP", epicsThreadPriorityCAServerLow)
     ,searchRx(event_new(tcp_loop.base, searchTx.sock, EV_READ|EV_PERSIST, &Pvt::onSearchS, this))
-    ,searchTimer(event_new(tcp_loop.base, -1, EV_TIMEOUT, &Pvt::tickSearchS, this))
     ,manager(UDPManager::instance())
     ,beaconCleaner(event_new(manager.loop().base, -1, EV_TIMEOUT|EV_PERSIST, &Pvt::tickBeaconCleanS, this))
     ,cacheCleaner(event_new(tcp_loop.base, -1, EV_TIMEOUT|EV_PERSIST, &Pvt::cacheCleanS, this))
 {
     effective.expand();
 
-    searchBuckets.resize(nBuckets);
+    if(effective.tcp_workers<=1u) {
+        workers.emplace_back(new ContextWorker(this, 0u, tcp_loop));
+
+    } else {
+        workers.reserve(effective.tcp_workers);
+        for(auto i : range(effective.tcp_workers)) {
+            evbase loop(SB()<<"PVXCTCP"<<i, epicsThreadPriorityCAServerLow);
+            workers.emplace_back(new ContextWorker(this, i, loop));
+        }
+    }
 
     std::set<std::string> bcasts;
     for(auto& addr : searchTx.interfaces()) {
@@ -369,8 +414,10 @@ Context::Pvt::Pvt(const Config& conf)
         listener->start();
     }
 
-    if(event_add(searchTimer.get(), &bucketInterval))
-        log_err_printf(setup, "Error enabling search timer\n%s", "");
+    for(auto& worker : workers) {
+        if(event_add(worker->searchTimer.get(), &bucketInterval))
+            log_err_printf(setup, "Error enabling search timer\n%s", "");
+    }
     if(event_add(searchRx.get(), nullptr))
         log_err_printf(setup, "Error enabling search RX\n%s", "");
     if(event_add(beaconCleaner.get(), &beaconCleanInterval))
@@ -385,31 +432,38 @@ void Context::Pvt::close()
 {
     // terminate all active connections
     tcp_loop.call([this]() {
-        (void)event_del(searchTimer.get());
         (void)event_del(searchRx.get());
         (void)event_del(beaconCleaner.get());
         (void)event_del(cacheCleaner.get());
+    });
 
-        auto conns(std::move(connByAddr));
-        // explicitly break ref. loop of channel cache
-        auto chans(std::move(chanByName));
+    for(auto& worker : workers) {
+        worker->loop.call([&worker]() {
+            (void)event_del(worker->searchTimer.get());
 
-        for(auto& pair : conns) {
-            auto conn = pair.second.lock();
-            if(!conn)
-                continue;
+            auto conns(std::move(worker->connByAddr));
+            // explicitly break ref. loop of channel cache
+            auto chans(std::move(worker->chanByName));
 
-            conn->cleanup();
-        }
+            for(auto& pair : conns) {
+                auto conn = pair.second.lock();
+                if(!conn)
+                    continue;
 
-        conns.clear();
-        chans.clear();
+                conn->cleanup();
+            }
 
-        // internal_self.use_count() may be >1 if
-        // we are orphaning some Operations
-    });
+            conns.clear();
+            chans.clear();
+
+            // internal_self.use_count() may be >1 if
+            // we are orphaning some Operations
+        });
+    }
 
     tcp_loop.sync();
+    for(auto& worker : workers)
+        worker->loop.sync();
 
     // ensure any in-progress callbacks have completed
     manager.sync();
@@ -436,8 +490,15 @@ void Context::Pvt::poke(bool force)
     log_debug_printf(setup, "hurryUp()%s\n", "");
 
     timeval immediate{0,0};
-    if(event_add(searchTimer.get(), &immediate))
-        throw std::runtime_error("Unable to schedule searchTimer");
+    for(auto& worker : workers) {
+        if(event_add(worker->searchTimer.get(), &immediate))
+            throw std::runtime_error("Unable to schedule searchTimer");
+    }
+}
+
+ContextWorker* Context::Pvt::workerFor(const std::string& name) const
+{
+    return workers[std::hash<std::string>()(name) % workers.size()].get();
 }
 
 void Context::Pvt::onBeacon(const UDPManager::Beacon& msg)
@@ -447,13 +508,34 @@ void Context::Pvt::onBeacon(const UDPManager::Beacon& msg)
     epicsTimeStamp now;
     epicsTimeGetCurrent(&now);
 
-    auto it = beaconSenders.find(msg.src);
+    // key on the advertised TCP endpoint.  A restarted server sends beacons
+    // from a different ephemeral port, but usually listens on the same TCP port.
+    auto it = beaconSenders.find(msg.server);
     if(it!=beaconSenders.end() && msg.guid==it->second.guid) {
         it->second.lastRx = now;
         return;
+
+    } else if(it!=beaconSenders.end()) {
+        // known sender with a new GUID.  Server has restarted.
+        // Only re-search those Channels last found through the old GUID.
+        const auto prev = it->second.guid;
+        it->second = BTrack{msg.guid, now};
+
+        log_debug_printf(io, "%s Restarted server %02x%02x%02x%02x%02x%02x%02x%02x%02x%02x%02x%02x %s\n",
+                   msg.src.tostring().c_str(),
+                   guid[0], guid[1], guid[2], guid[3], guid[4], guid[5], guid[6], guid[7], guid[8], guid[9], guid[10], guid[11],
+                   msg.server.tostring().c_str());
+
+        for(auto& worker : workers) {
+            auto W = worker.get();
+            W->loop.dispatch([W, prev]() {
+                W->researchServer(prev);
+            });
+        }
+        return;
     }
 
-    beaconSenders.emplace(msg.src, BTrack{msg.guid, now});
+    beaconSenders.emplace(msg.server, BTrack{msg.guid, now});
 
     log_debug_printf(io, "%s New server %02x%02x%02x%02x%02x%02x%02x%02x%02x%02x%02x%02x %s\n",
                msg.src.tostring().c_str(),
@@ -463,21 +545,11 @@ void Context::Pvt::onBeacon(const UDPManager::Beacon& msg)
     poke(false);
 }
 
-bool Context::Pvt::onSearch()
+bool Context::Pvt::onSearch(unsigned& nrx)
 {
-    searchMsg.resize(0x10000);
-    SockAddr src;
-    uint32_t ndrop = 0u;
-
-    osiSocklen_t alen = src.size();
-    const int nrx = recvfromx(searchTx.sock, (char*)&searchMsg[0], searchMsg.size()-1, &src->sa, &alen, &ndrop);
-
-    if(nrx>=0 && ndrop!=0 && prevndrop!=ndrop) {
-        log_debug_printf(io, "UDP search reply buffer overflow %u -> %u\n", unsigned(prevndrop), unsigned(ndrop));
-        prevndrop = ndrop;
-    }
+    const int n = searchBatch.receive(searchTx.sock);
 
-    if(nrx<0) {
+    if(n<0) {
         int err = evutil_socket_geterror(searchTx.sock);
         if(err==SOCK_EWOULDBLOCK || err==EAGAIN || err==SOCK_EINTR) {
             // nothing to do here
@@ -486,13 +558,32 @@ bool Context::Pvt::onSearch()
                        evutil_socket_error_to_string(err));
         }
         return false; // wait for more I/O
+    }
+
+    for(auto i : range(size_t(n))) {
+        auto& dg = searchBatch[i];
+
+        if(dg.ndrop!=0 && prevndrop!=dg.ndrop) {
+            log_debug_printf(io, "UDP search reply buffer overflow %u -> %u\n", unsigned(prevndrop), unsigned(dg.ndrop));
+            prevndrop = dg.ndrop;
+        }
+
+        onSearchMsg(dg.src, dg.buf, dg.len);
+    }
+
+    nrx += unsigned(n);
+    // a partial batch means the socket buffer is empty
+    return size_t(n)==searchBatch.capacity();
+}
 
-    } else if(nrx<8) {
+void Context::Pvt::onSearchMsg(const SockAddr& src, uint8_t *searchMsg, size_t nrx)
+{
+    if(nrx<8) {
         // maybe a zero (body) length packet?
         // maybe an OS error?
 
         log_info_printf(io, "UDP ignore runt%s\n", "");
-        return true;
+        return;
 
     } else if(searchMsg[0]!=0xca || searchMsg[1]==0 || (searchMsg[2]&(pva_flags::Control|pva_flags::SegMask))) {
         // minimum header size is 8 bytes
@@ -502,14 +593,14 @@ bool Context::Pvt::onSearch()
 
         log_info_printf(io, "UDP ignore header%u %02x%02x%02x%02x\n",
                    unsigned(nrx), searchMsg[0], searchMsg[1], searchMsg[2], searchMsg[3]);
-        return true;
+        return;
     }
 
-    log_hex_printf(io, Level::Debug, &searchMsg[0], nrx, "UDP search Rx %d from %s\n", nrx, src.tostring().c_str());
+    log_hex_printf(io, Level::Debug, &searchMsg[0], nrx, "UDP search Rx %u from %s\n", unsigned(nrx), src.tostring().c_str());
 
     bool be = searchMsg[2]&pva_flags::MSB;
 
-    FixedBuf M(be, searchMsg.data(), nrx);
+    FixedBuf M(be, searchMsg, nrx);
 
     const uint8_t cmd = M[3];
     M.skip(4, __FILE__, __LINE__);
@@ -520,7 +611,7 @@ bool Context::Pvt::onSearch()
     if(len > M.size() && M.good()) {
         log_info_printf(io, "UDP ignore header%u %02x%02x%02x%02x\n",
                    unsigned(M.size()), M[0], M[1], M[2], M[3]);
-        return true;
+        return;
     }
 
     if(cmd==CMD_SEARCH_RESPONSE) {
@@ -541,16 +632,19 @@ bool Context::Pvt::onSearch()
         serv.setPort(port);
 
         if(M.size()<4u || M[0]!=3u || M[1]!='t' || M[2]!='c' || M[3]!='p')
-            return true;
+            return;
         M.skip(4u, __FILE__, __LINE__);
 
         from_wire(M, found);
         if(!found)
-            return true;
+            return;
 
         uint16_t nSearch = 0u;
         from_wire(M, nSearch);
 
+        // group by the worker owning each channel
+        std::vector<std::vector<uint32_t>> ids(workers.size());
+
         for(auto n : range(nSearch)) {
             (void)n;
 
@@ -559,38 +653,22 @@ bool Context::Pvt::onSearch()
             if(!M.good())
                 break;
 
-            std::shared_ptr<Channel> chan;
-            {
-                auto it = chanByCID.find(id);
-                if(it==chanByCID.end())
-                    continue;
-
-                chan = it->second.lock();
-                if(!chan)
-                    continue;
-            }
-
-            log_debug_printf(io, "Search reply for %s\n", chan->name.c_str());
-
-            if(chan->state==Channel::Searching) {
-                chan->guid = guid;
-                chan->replyAddr = serv;
-
-                auto it = connByAddr.find(serv);
-                if(it==connByAddr.end() || !(chan->conn = it->second.lock())) {
-                    connByAddr[serv] = chan->conn = std::make_shared<Connection>(internal_self.lock(), serv);
-                }
+            ids[id%workers.size()].push_back(id);
+        }
 
-                chan->conn->pending.push_back(chan);
-                chan->state = Channel::Connecting;
+        for(auto i : range(workers.size())) {
+            if(ids[i].empty())
+                continue;
 
-                chan->conn->createChannels();
+            auto worker = workers[i].get();
+            if(worker->loop.inLoop()) {
+                worker->onSearchReply(guid, serv, ids[i]);
 
-            } else if(chan->guid!=guid) {
-                log_err_printf(duppv, "Duplicate PV name %s from %s and %s\n",
-                               chan->name.c_str(),
-                               chan->replyAddr.tostring().c_str(),
-                               serv.tostring().c_str());
+            } else {
+                auto wids(std::move(ids[i]));
+                worker->loop.dispatch([worker, guid, serv, wids]() {
+                    worker->onSearchReply(guid, serv, wids);
+                });
             }
         }
 
@@ -600,11 +678,9 @@ bool Context::Pvt::onSearch()
 
     if(!M.good()) {
         log_hex_printf(io, Level::Err, &searchMsg[0], nrx,
-                "%s:%d Invalid search reply %d from %s\n",
-                M.file(), M.line(), nrx, src.tostring().c_str());
+                "%s:%d Invalid search reply %u from %s\n",
+                M.file(), M.line(), unsigned(nrx), src.tostring().c_str());
     }
-
-    return true;
 }
 
 void Context::Pvt::onSearchS(evutil_socket_t fd, short evt, void *raw)
@@ -615,9 +691,9 @@ void Context::Pvt::onSearchS(evutil_socket_t fd, short evt, void *raw)
             return;
 
         // limit number of packets processed before going back to the reactor
-        unsigned i;
+        unsigned i = 0u;
         const unsigned limit = 40;
-        for(i=0; i<limit && static_cast<Pvt*>(raw)->onSearch(); i++) {}
+        while(i<limit && static_cast<Pvt*>(raw)->onSearch(i)) {}
         log_debug_printf(io, "UDP search processed %u/%u\n", i, limit);
 
     }catch(std::exception& e){
@@ -625,11 +701,94 @@ void Context::Pvt::onSearchS(evutil_socket_t fd, short evt, void *raw)
     }
 }
 
-void Context::Pvt::tickSearch()
+ContextWorker::ContextWorker(Context::Pvt* context, size_t index, const evbase& loop)
+    :context(context)
+    ,index(index)
+    ,loop(loop)
+    ,searchBuckets(nBuckets)
+    ,searchTimer(event_new(loop.base, -1, EV_TIMEOUT, &ContextWorker::tickSearchS, this))
+{}
+
+void ContextWorker::onSearchReply(const std::array<uint8_t, 12>& guid, const SockAddr& serv, const std::vector<uint32_t>& ids)
+{
+    for(auto id : ids) {
+        std::shared_ptr<Channel> chan;
+        {
+            auto it = chanByCID.find(id);
+            if(it==chanByCID.end())
+                continue;
+
+            chan = it->second.lock();
+            if(!chan)
+                continue;
+        }
+
+        log_debug_printf(io, "Search reply for %s\n", chan->name.c_str());
+
+        if(chan->state==Channel::Searching) {
+            chan->guid = guid;
+            connectChannel(chan, serv);
+
+        } else if(chan->guid!=guid) {
+            log_err_printf(duppv, "Duplicate PV name %s from %s and %s\n",
+                           chan->name.c_str(),
+                           chan->replyAddr.tostring().c_str(),
+                           serv.tostring().c_str());
+        }
+    }
+}
+
+void ContextWorker::connectChannel(const std::shared_ptr<Channel>& chan, const SockAddr& serv)
+{
+    chan->replyAddr = serv;
+
+    auto it = connByAddr.find(serv);
+    if(it==connByAddr.end() || !(chan->conn = it->second.lock())) {
+        connByAddr[serv] = chan->conn = std::make_shared<Connection>(context->internal_self.lock(), this, serv);
+    }
+
+    chan->conn->pending.push_back(chan);
+    chan->state = Channel::Connecting;
+
+    chan->conn->createChannels();
+}
+
+void ContextWorker::researchServer(const std::array<uint8_t, 12>& guid)
+{
+    auto& dest = searchBuckets[currentBucket];
+    size_t nmoved = 0u;
+
+    for(auto& bucket : searchBuckets) {
+        auto it = bucket.begin();
+        while(it!=bucket.end()) {
+            auto cur = it++;
+
+            auto chan = cur->lock();
+            if(!chan || chan->state!=Channel::Searching || chan->guid!=guid)
+                continue;
+
+            // forget backoff, and search on the next tick
+            chan->nSearch = 0u;
+            if(&bucket!=&dest)
+                dest.splice(dest.end(), bucket, cur);
+            nmoved++;
+        }
+    }
+
+    log_debug_printf(io, "Re-search %zu channels of restarted server\n", nmoved);
+
+    if(nmoved) {
+        timeval immediate{0,0};
+        if(event_add(searchTimer.get(), &immediate))
+            log_err_printf(setup, "Error scheduling search timer\n%s", "");
+    }
+}
+
+void ContextWorker::tickSearch()
 {
     {
-        Guard G(pokeLock);
-        poked = false;
+        Guard G(context->pokeLock);
+        context->poked = false;
     }
 
     auto idx = currentBucket;
@@ -640,7 +799,25 @@ void Context::Pvt::tickSearch()
     decltype (searchBuckets)::value_type bucket;
     searchBuckets[idx].swap(bucket);
 
+    // accumulate rate limit credit for up to one bucketInterval
+    const double maxRate = context->effective.search_max_rate;
+    if(maxRate>0.0) {
+        const double budget = maxRate/context->workers.size();
+        const epicsTime now(epicsTime::getCurrent());
+        const double dt = std::max(0.0, now - searchLastTick);
+        searchCredit = std::min(searchCredit + dt*budget, budget*bucketInterval.tv_sec);
+        searchLastTick = now;
+    }
+
     while(!bucket.empty()) {
+        if(maxRate>0.0 && searchCredit<=0.0) {
+            // over budget.  defer remaining Channels to the next tick, without backoff.
+            log_debug_printf(io, "Search tick %zu defers %zu channels\n", idx, bucket.size());
+            auto& nextBucket = searchBuckets[currentBucket];
+            nextBucket.splice(nextBucket.begin(), bucket);
+            break;
+        }
+
         searchMsg.resize(0x10000);
         FixedBuf M(true, searchMsg.data(), searchMsg.size());
         M.skip(8, __FILE__, __LINE__); // fill in header after body length known
@@ -660,7 +837,7 @@ void Context::Pvt::tickSearch()
         to_wire(M, uint32_t(0u));
         to_wire(M, uint32_t(0u));
 
-        to_wire(M, uint16_t(searchRxPort));
+        to_wire(M, uint16_t(context->searchRxPort));
 
         to_wire(M, uint8_t(1u));
         to_wire(M, "tcp");
@@ -676,6 +853,12 @@ void Context::Pvt::tickSearch()
             if(!chan || chan->state!=Channel::Searching) {
                 bucket.pop_front();
                 continue;
+
+            } else if(chan->forcedServer.family()!=AF_UNSPEC) {
+                // no search.  (re)connect once per tick until successful
+                bucket.pop_front();
+                connectChannel(chan, chan->forcedServer);
+                continue;
             }
 
             auto save = M.save();
@@ -698,18 +881,10 @@ void Context::Pvt::tickSearch()
 
             count++;
 
-            auto ninc = chan->nSearch = std::min(searchBuckets.size(), chan->nSearch+1u);
+            // exponential backoff.  1, 2, 4, ... ticks, up to once per revolution of the wheel
+            chan->nSearch++;
+            auto ninc = std::min(searchBuckets.size(), size_t(1u)<<std::min(chan->nSearch-1u, size_t(16u)));
             auto next = (idx + ninc)%searchBuckets.size();
-            auto nextnext = (next + 1u)%searchBuckets.size();
-
-            // try to smooth out UDP bcast load by waiting one extra tick
-            {
-                auto nextN = searchBuckets[next].size();
-                auto nextnextN = searchBuckets[nextnext].size();
-
-                if(nextN > nextnextN && (nextN-nextnextN > 100u))
-                    next = nextnext;
-            }
 
             auto& nextBucket = searchBuckets[next];
 
@@ -732,38 +907,55 @@ void Context::Pvt::tickSearch()
             FixedBuf H(true, searchMsg.data(), 8);
             to_wire(H, Header{CMD_SEARCH, 0, uint32_t(consumed-8u)});
         }
-        for(auto& pair : searchDest) {
+        for(auto& pair : context->searchDest) {
             *pflags = pair.second ? 0x80 : 0x00;
 
-            int ntx = sendto(searchTx.sock, (char*)searchMsg.data(), consumed, 0, &pair.first->sa, pair.first.size());
+            searchTx.push(searchMsg.data(), consumed, pair.first);
+        }
+        if(maxRate>0.0)
+            searchCredit -= double(context->searchDest.size());
+    }
 
-            if(ntx<0) {
-                int err = evutil_socket_geterror(searchTx.sock);
-                auto lvl = Level::Warn;
-                if(err==EINTR || err==EPERM)
-                    lvl = Level::Debug;
-                log_printf(io, lvl, "Search tx error (%d) %s\n",
-                           err, evutil_socket_error_to_string(err));
+    // send everything queued during this tick together
+    const auto nsyscall0 = searchTx.nsyscall;
+    const auto npacket0 = searchTx.npacket;
 
-            } else if(unsigned(ntx)<consumed) {
-                log_warn_printf(io, "Search truncated %u < %u",
-                           unsigned(ntx), unsigned(consumed));
+    (void)searchTx.flush(context->searchTx.sock);
 
-            } else {
-                log_debug_printf(io, "Search to %s %s\n", pair.first.tostring().c_str(),
-                                 pair.second ? "ucast" : "bcast");
-            }
+    for(auto i : range(searchTx.size())) {
+        auto& dg = searchTx[i];
+
+        if(dg.ntx<0) {
+            auto lvl = Level::Warn;
+            if(dg.err==EINTR || dg.err==EPERM)
+                lvl = Level::Debug;
+            log_printf(io, lvl, "Search tx error (%d) %s\n",
+                       dg.err, evutil_socket_error_to_string(dg.err));
+
+        } else if(size_t(dg.ntx)<dg.buf.size()) {
+            log_warn_printf(io, "Search truncated %u < %u",
+                       unsigned(dg.ntx), unsigned(dg.buf.size()));
+
+        } else {
+            // flags follow the header and searchSequenceID
+            log_debug_printf(io, "Search to %s %s\n", dg.dest.tostring().c_str(),
+                             (dg.buf[12]&0x80) ? "ucast" : "bcast");
         }
     }
+    searchTx.clear();
+
+    if(searchTx.npacket!=npacket0)
+        log_debug_printf(io, "Search tick %zu sent %zu packets with %zu syscalls\n",
+                         idx, searchTx.npacket - npacket0, searchTx.nsyscall - nsyscall0);
 
     if(event_add(searchTimer.get(), &bucketInterval))
         log_err_printf(setup, "Error re-enabling search timer on\n%s", "");
 }
 
-void Context::Pvt::tickSearchS(evutil_socket_t fd, short evt, void *raw)
+void ContextWorker::tickSearchS(evutil_socket_t fd, short evt, void *raw)
 {
     try {
-        static_cast<Pvt*>(raw)->tickSearch();
+        static_cast<ContextWorker*>(raw)->tickSearch();
     }catch(std::exception& e){
         log_exc_printf(io, "Unhandled error in search timer callback: %s\n", e.what());
     }
@@ -800,15 +992,15 @@ void Context::Pvt::tickBeaconCleanS(evutil_socket_t fd, short evt, void *raw)
     }
 }
 
-void Context::Pvt::cacheClean()
+void ContextWorker::cacheClean()
 {
-    std::set<std::string> trash;
+    std::set<decltype (chanByName)::key_type> trash;
 
     for(auto& pair : chanByName) {
         if(pair.second.use_count()<=1) {
             if(!pair.second->garbage) {
                 // mark for next sweep
-                log_debug_printf(setup, "Chan GC mark '%s'\n", pair.first.c_str());
+                log_debug_printf(setup, "Chan GC mark '%s'\n", pair.first.first.c_str());
                 pair.second->garbage = true;
 
             } else {
@@ -819,9 +1011,9 @@ void Context::Pvt::cacheClean()
     }
 
     // explicitly break ref. loop of channel cache
-    for(auto& name : trash) {
-        chanByName.erase(name);
-        log_debug_printf(setup, "Chan GC sweep '%s'\n", name.c_str());
+    for(auto& key : trash) {
+        chanByName.erase(key);
+        log_debug_printf(setup, "Chan GC sweep '%s'\n", key.first.c_str());
     }
 }
 
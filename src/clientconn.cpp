@@ -14,14 +14,17 @@ namespace client {
 
 DEFINE_LOGGER(io, "pvxs.client.io");
 
-Connection::Connection(const std::shared_ptr<Context::Pvt>& context, const SockAddr& peerAddr)
+Connection::Connection(const std::shared_ptr<Context::Pvt>& context, ContextWorker* worker, const SockAddr& peerAddr)
     :ConnBase (true,
-               bufferevent_socket_new(context->tcp_loop.base, -1, BEV_OPT_CLOSE_ON_FREE|BEV_OPT_DEFER_CALLBACKS),
+               bufferevent_socket_new(worker->loop.base, -1, BEV_OPT_CLOSE_ON_FREE|BEV_OPT_DEFER_CALLBACKS),
                peerAddr)
     ,context(context)
-    ,echoTimer(event_new(context->tcp_loop.base, -1, EV_TIMEOUT|EV_PERSIST, &tickEchoS, this))
+    ,worker(worker)
+    ,echoTimer(event_new(worker->loop.base, -1, EV_TIMEOUT|EV_PERSIST, &tickEchoS, this))
 {
-    bufferevent_setcb(bev.get(), &bevReadS, nullptr, &bevEventS, this);
+    bufferevent_setcb(bev.get(), &bevReadS, &bevWriteS, &bevEventS, this);
+
+    txSegSize = context->effective.tcp_segment_size;
 
     // shorter timeout until connect() ?
     bufferevent_set_timeouts(bev.get(), &tcp_timeout, &tcp_timeout);
@@ -114,7 +117,7 @@ void Connection::cleanup()
     // (maybe) keep myself alive
     std::shared_ptr<Connection> self;
 
-    context->connByAddr.erase(peerAddr);
+    worker->connByAddr.erase(peerAddr);
 
     if(bev)
         bev.reset();
@@ -321,7 +324,7 @@ void Connection::handle_CREATE_CHANNEL()
         // server refuses to create a channel, but presumably responded positivly to search
 
         chan->state = Channel::Searching;
-        context->searchBuckets[context->currentBucket].push_back(chan);
+        worker->searchBuckets[worker->currentBucket].push_back(chan);
 
         log_warn_printf(io, "Server %s refuses channel to '%s' : %s\n", peerName.c_str(),
                         chan->name.c_str(), sts.msg.c_str());
@@ -329,6 +332,8 @@ void Connection::handle_CREATE_CHANNEL()
     } else {
         chan->state = Channel::Active;
         chan->sid = sid;
+        // any later search starts again without backoff
+        chan->nSearch = 0u;
 
         chanBySID[sid] = chan;
 
@@ -372,7 +377,7 @@ void Connection::handle_DESTROY_CHANNEL()
     chan->state = Channel::Searching;
     chan->sid = 0xdeadbeef; // spoil
     self = std::move(chan->conn);
-    context->searchBuckets[context->currentBucket].push_back(chan);
+    worker->searchBuckets[worker->currentBucket].push_back(chan);
 
     for(auto& pair : chan->opByIOID) {
         auto op = pair.second->handle.lock();
@@ -391,9 +396,9 @@ void Connection::tickEcho()
     if(!bev)
         return;
 
-    auto tx = bufferevent_get_output(bev.get());
-
-    to_evbuf(tx, Header{CMD_ECHO, 0u, 0u}, hostBE);
+    // empty body.  queued behind any segmented message in progress
+    (void)evbuffer_drain(txBody.get(), evbuffer_get_length(txBody.get()));
+    enqueueTxBody(CMD_ECHO);
 
     // maybe help reduce latency
     bufferevent_flush(bev.get(), EV_WRITE, BEV_FLUSH);
@@ -32,7 +32,7 @@ struct PRBase::Args
             if(auto fld = ret[pair.first]) {
                 try {
                     auto store = Value::Helper::store(pair.second.first);
-                    fld.copyIn(static_cast<const void*>(&store->store), store->code);
+                    fld.copyIn(store->buffer(), store->code);
                 }catch(NoConvert& e){
                     if(pair.second.second)
                         throw;
@@ -131,7 +131,7 @@ struct GPROp : public OperationBase
         :OperationBase (op, chan)
     {}
     ~GPROp() {
-        chan->context->tcp_loop.assertInLoop();
+        chan->worker->loop.assertInLoop();
         _cancel(true);
     }
 
@@ -167,7 +167,7 @@ struct GPROp : public OperationBase
         auto context = chan->context;
         decltype (done) junk;
         bool ret;
-        context->tcp_loop.call([this, &junk, &ret](){
+        chan->worker->loop.call([this, &junk, &ret](){
             ret = _cancel(false);
             junk = std::move(done);
             // leave opByIOID for GC
@@ -462,7 +462,7 @@ static
 void gpr_cleanup(std::shared_ptr<Operation>& ret, std::shared_ptr<GPROp>&& op)
 {
     auto cap(std::move(op));
-    auto loop(cap->chan->context->tcp_loop);
+    auto loop(cap->chan->worker->loop);
     ret.reset(cap.get(), [cap, loop](Operation*) mutable {
         auto L(std::move(loop));
         // from use thread
@@ -489,8 +489,9 @@ std::shared_ptr<Operation> GetBuilder::_exec_get()
     std::shared_ptr<Operation> ret;
     assert(_get);
 
-    ctx->tcp_loop.call([&ret, this]() {
-        auto chan = Channel::build(ctx->shared_from_this(), _name);
+    auto worker = ctx->workerFor(_name);
+    worker->loop.call([&ret, this, worker]() {
+        auto chan = Channel::build(ctx->shared_from_this(), worker, _name, _server);
 
         auto op = std::make_shared<GPROp>(Operation::Get, chan);
         op->setDone(std::move(_result));
@@ -516,8 +517,9 @@ std::shared_ptr<Operation> PutBuilder::exec()
     if(!_builder && !_args)
         throw std::logic_error("put() needs either a .build() or at least one .set()");
 
-    ctx->tcp_loop.call([&ret, this]() {
-        auto chan = Channel::build(ctx->shared_from_this(), _name);
+    auto worker = ctx->workerFor(_name);
+    worker->loop.call([&ret, this, worker]() {
+        auto chan = Channel::build(ctx->shared_from_this(), worker, _name, _server);
 
         auto op = std::make_shared<GPROp>(Operation::Put, chan);
         op->setDone(std::move(_result));
@@ -557,8 +559,9 @@ std::shared_ptr<Operation> RPCBuilder::exec()
     if(_args && _argument)
         throw std::logic_error("Use of rpc() with argument and builder .arg() are mutually exclusive");
 
-    ctx->tcp_loop.call([&ret, this]() {
-        auto chan = Channel::build(ctx->shared_from_this(), _name);
+    auto worker = ctx->workerFor(_name);
+    worker->loop.call([&ret, this, worker]() {
+        auto chan = Channel::build(ctx->shared_from_this(), worker, _name, _server);
 
         auto op = std::make_shared<GPROp>(Operation::RPC, chan);
         op->setDone(std::move(_result));
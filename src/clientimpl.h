@@ -24,6 +24,8 @@ namespace pvxs {
 namespace client {
 
 struct Channel;
+struct Connection;
+struct ContextWorker;
 
 struct ResultWaiter {
     epicsMutex lock;
@@ -65,12 +67,16 @@ struct RequestInfo {
     const std::weak_ptr<OperationBase> handle;
 
     Value prototype;
+    // MONITOR updates of prototype's type
+    impl::DecodePlan plan;
 
     RequestInfo(uint32_t sid, uint32_t ioid, std::shared_ptr<OperationBase>& handle);
 };
 
 struct Connection : public ConnBase, public std::enable_shared_from_this<Connection> {
     const std::shared_ptr<Context::Pvt> context;
+    // valid while context is alive
+    ContextWorker* const worker;
 
     const evevent echoTimer;
 
@@ -89,7 +95,7 @@ struct Connection : public ConnBase, public std::enable_shared_from_this<Connect
 
     INST_COUNTER(Connection);
 
-    Connection(const std::shared_ptr<Context::Pvt>& context, const SockAddr &peerAddr);
+    Connection(const std::shared_ptr<Context::Pvt>& context, ContextWorker* worker, const SockAddr &peerAddr);
     virtual ~Connection();
 
     void createChannels();
@@ -124,6 +130,8 @@ protected:
 
 struct Channel {
     const std::shared_ptr<Context::Pvt> context;
+    // valid while context is alive
+    ContextWorker* const worker;
     const std::string name;
     // Our choosen ID for this channel.
     // used as persistent CID and searchID
@@ -144,10 +152,14 @@ struct Channel {
     // when state==Searching, number of repeatitions
     size_t nSearch = 0u;
 
-    // GUID of last positive reply when state!=Searching
-    std::array<uint8_t, 12> guid;
+    // GUID of last positive reply.  Kept when state==Searching
+    // to find Channels of a restarted server.
+    std::array<uint8_t, 12> guid{};
     SockAddr replyAddr;
 
+    // when set, connect to this server without searching.  cf. CommonBuilder::server()
+    SockAddr forcedServer;
+
     std::list<std::weak_ptr<OperationBase>> pending;
 
     // points to storage of Connection::opByIOID
@@ -155,14 +167,56 @@ struct Channel {
 
     INST_COUNTER(Channel);
 
-    Channel(const std::shared_ptr<Context::Pvt>& context, const std::string& name, uint32_t cid);
+    Channel(const std::shared_ptr<Context::Pvt>& context, ContextWorker* worker, const std::string& name, uint32_t cid);
     ~Channel();
 
     void createOperations();
     void disconnect(const std::shared_ptr<Channel>& self);
 
     static
-    std::shared_ptr<Channel> build(const std::shared_ptr<Context::Pvt>& context, const std::string &name);
+    std::shared_ptr<Channel> build(const std::shared_ptr<Context::Pvt>& context, ContextWorker* worker,
+                                   const std::string &name, const std::string& server);
+};
+
+/* One event loop servicing a subset of Channels, their Operations,
+ * and the Connections they use.  Channels are assigned by name,
+ * so each is only ever accessed from the loop of its worker.
+ */
+struct ContextWorker {
+    Context::Pvt* const context;
+    const size_t index;
+    evbase loop;
+
+    uint32_t nextCID=0x12345678;
+
+    std::vector<uint8_t> searchMsg;
+    // outgoing search requests, sent at the end of each tick
+    UDPTxBatch searchTx;
+    // search rate limit credit, in datagrams.  cf. Config::search_max_rate
+    double searchCredit = 0.0;
+    epicsTime searchLastTick;
+
+    size_t currentBucket = 0u;
+    std::vector<std::list<std::weak_ptr<Channel>>> searchBuckets;
+
+    std::map<uint32_t, std::weak_ptr<Channel>> chanByCID;
+    // strong ref. loop through Channel::context
+    // explicitly broken by Context::close(), Context::cacheClear, or cacheClean()
+    // by name and forced server (usually empty)
+    std::map<std::pair<std::string, std::string>, std::shared_ptr<Channel>> chanByName;
+
+    std::map<SockAddr, std::weak_ptr<Connection>> connByAddr;
+
+    const evevent searchTimer;
+
+    ContextWorker(Context::Pvt* context, size_t index, const evbase& loop);
+
+    void onSearchReply(const std::array<uint8_t, 12>& guid, const SockAddr& serv, const std::vector<uint32_t>& ids);
+    void connectChannel(const std::shared_ptr<Channel>& chan, const SockAddr& serv);
+    void researchServer(const std::array<uint8_t, 12>& guid);
+    void tickSearch();
+    static void tickSearchS(evutil_socket_t fd, short evt, void *raw);
+    void cacheClean();
 };
 
 struct Context::Pvt
@@ -180,7 +234,6 @@ struct Context::Pvt
 
     const Value caMethod;
 
-    uint32_t nextCID=0x12345678;
     uint32_t prevndrop = 0u;
 
     evsocket searchTx;
@@ -191,31 +244,25 @@ struct Context::Pvt
     epicsTimeStamp lastPoke{};
     bool poked = false;
 
-    std::vector<uint8_t> searchMsg;
+    // search reply buffers
+    UDPRxBatch searchBatch{16u};
 
     // search destination address and whether to set the unicast flag
     std::vector<std::pair<SockAddr, bool>> searchDest;
 
-    size_t currentBucket = 0u;
-    std::vector<std::list<std::weak_ptr<Channel>>> searchBuckets;
-
     std::list<std::unique_ptr<UDPListener> > beaconRx;
 
-    std::map<uint32_t, std::weak_ptr<Channel>> chanByCID;
-    // strong ref. loop through Channel::context
-    // explicitly broken by Context::close(), Context::cacheClear, or Context::Pvt::cacheClean()
-    std::map<std::string, std::shared_ptr<Channel>> chanByName;
-
-    std::map<SockAddr, std::weak_ptr<Connection>> connByAddr;
-
     evbase tcp_loop;
     const evevent searchRx;
-    const evevent searchTimer;
+
+    // size()>=1.  With one worker, it shares tcp_loop
+    std::vector<std::unique_ptr<ContextWorker>> workers;
 
     struct BTrack {
         std::array<uint8_t, 12> guid;
         epicsTimeStamp lastRx;
     };
+    // by server TCP endpoint
     std::map<SockAddr, BTrack> beaconSenders;
 
     // beacon handling done on UDP worker.
@@ -236,13 +283,13 @@ struct Context::Pvt
 
     void onBeacon(const UDPManager::Beacon& msg);
 
-    bool onSearch();
+    ContextWorker* workerFor(const std::string& name) const;
+
+    bool onSearch(unsigned& nrx);
+    void onSearchMsg(const SockAddr& src, uint8_t *searchMsg, size_t nrx);
     static void onSearchS(evutil_socket_t fd, short evt, void *raw);
-    void tickSearch();
-    static void tickSearchS(evutil_socket_t fd, short evt, void *raw);
     void tickBeaconClean();
     static void tickBeaconCleanS(evutil_socket_t fd, short evt, void *raw);
-    void cacheClean();
     static void cacheCleanS(evutil_socket_t fd, short evt, void *raw);
 };
 
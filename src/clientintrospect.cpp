@@ -36,7 +36,7 @@ struct InfoOp : public OperationBase
 
     virtual ~InfoOp()
     {
-        chan->context->tcp_loop.assertInLoop();
+        chan->worker->loop.assertInLoop();
         _cancel(true);
     }
 
@@ -44,7 +44,7 @@ struct InfoOp : public OperationBase
         auto context = chan->context;
         decltype (done) junk;
         bool ret = false;
-        context->tcp_loop.call([this, &junk, &ret](){
+        chan->worker->loop.call([this, &junk, &ret](){
             ret = _cancel(false);
             junk = std::move(done);
             // leave opByIOID for GC
@@ -180,8 +180,9 @@ std::shared_ptr<Operation> GetBuilder::_exec_info()
 
     assert(!_get);
 
-    ctx->tcp_loop.call([&ret, this]() {
-        auto chan = Channel::build(ctx->shared_from_this(), _name);
+    auto worker = ctx->workerFor(_name);
+    worker->loop.call([&ret, this, worker]() {
+        auto chan = Channel::build(ctx->shared_from_this(), worker, _name, _server);
 
         auto op = std::make_shared<InfoOp>(chan);
 
@@ -197,7 +198,7 @@ std::shared_ptr<Operation> GetBuilder::_exec_info()
         chan->pending.push_back(op);
         chan->createOperations();
 
-        auto loop(op->chan->context->tcp_loop);
+        auto loop(op->chan->worker->loop);
         ret.reset(op.get(), [op, loop](Operation*) mutable {
             // on user thread
             auto temp(std::move(op));
@@ -12,6 +12,7 @@
 
 #include <pvxs/log.h>
 #include "clientimpl.h"
+#include "pvrequest.h"
 
 namespace pvxs {
 namespace client {
@@ -24,6 +25,8 @@ DEFINE_LOGGER(io, "pvxs.client.io");
 namespace {
 struct Entry {
     Value val;
+    // fields of val overwritten by squashed updates, by server and/or client.
+    BitMask overrun;
     std::exception_ptr exc;
     Entry() = default;
     Entry(Value&& v) :val(std::move(v)) {}
@@ -46,7 +49,7 @@ struct SubscriptionImpl : public OperationBase, public Subscription
     bool maskConn = false, maskDiscon = true;
     uint32_t queueSize = 4u, ackAt=0u;
 
-    // only access from tcp_loop
+    // only access from worker loop
 
     enum state_t : uint8_t {
         Connecting, // waiting for an active Channel
@@ -70,10 +73,10 @@ struct SubscriptionImpl : public OperationBase, public Subscription
     SubscriptionImpl(operation_t op, const std::shared_ptr<Channel>& chan)
         :OperationBase (op, chan)
         ,channelName(chan->name)
-        ,ackTick(event_new(chan->context->tcp_loop.base, -1, EV_TIMEOUT, &tickAckS, this))
+        ,ackTick(event_new(chan->worker->loop.base, -1, EV_TIMEOUT, &tickAckS, this))
     {}
     virtual ~SubscriptionImpl() {
-        chan->context->tcp_loop.assertInLoop();
+        chan->worker->loop.assertInLoop();
         _cancel(true);
     }
 
@@ -100,7 +103,7 @@ struct SubscriptionImpl : public OperationBase, public Subscription
 
     virtual void pause(bool p) override final
     {
-        chan->context->tcp_loop.call([this, p](){
+        chan->worker->loop.call([this, p](){
             log_info_printf(io, "Server %s channel %s monitor %s\n",
                             chan->conn ? chan->conn->peerName.c_str() : "<disconnected>",
                             chan->name.c_str(),
@@ -128,13 +131,25 @@ struct SubscriptionImpl : public OperationBase, public Subscription
     }
 
     virtual Value pop() override final
+    {
+        return _pop(nullptr);
+    }
+
+    virtual Value pop(Value& overrun) override final
+    {
+        return _pop(&overrun);
+    }
+
+    Value _pop(Value* overrun)
     {
         Value ret;
+        if(overrun)
+            *overrun = Value();
         {
             Guard G(lock);
 
             if(!queue.empty()) {
-                auto ent(queue.front());
+                auto ent(std::move(queue.front()));
                 queue.pop_front();
 
                 if(pipeline) {
@@ -162,6 +177,13 @@ struct SubscriptionImpl : public OperationBase, public Subscription
                 else
                     ret = std::move(ent.val);
 
+                if(overrun && ret) {
+                    *overrun = ret.cloneEmpty();
+                    auto store = Value::Helper::store_ptr(*overrun);
+                    for(auto bit : ent.overrun.onlySet())
+                        store[bit].valid = true;
+                }
+
             } else {
                 needNotify = true;
 
@@ -176,7 +198,7 @@ struct SubscriptionImpl : public OperationBase, public Subscription
         auto context = chan->context;
         decltype (event) junk;
         bool ret;
-        context->tcp_loop.call([this, &junk, &ret](){
+        chan->worker->loop.call([this, &junk, &ret](){
             ret = _cancel(false);
             junk = std::move(event);
             // leave opByIOID for GC
@@ -345,6 +367,7 @@ void Connection::handle_MONITOR()
     uint8_t subcmd=0;
     Status sts{};
     Value data; // hold prototype (INIT) or reply data
+    BitMask overrun;
 
     from_wire(M, ioid);
     from_wire(M, subcmd);
@@ -384,15 +407,16 @@ void Connection::handle_MONITOR()
 
         } else if(init) {
             info->prototype = std::move(data);
+            info->plan.reset(info->prototype);
 
         } else if(!final || !M.empty()) {
 
             data = info->prototype.cloneEmpty();
-            from_wire_valid(M, rxRegistry, data);
+            from_wire_valid(M, rxRegistry, data, info->plan);
 
-            BitMask overrun;
             from_wire(M, overrun);
-            (void)overrun; // ignoring
+            // encoding rounds # of bits to whole bytes, so we may trim
+            overrun.resize(Value::Helper::desc(data)->size());
         }
     }
 
@@ -454,6 +478,7 @@ void Connection::handle_MONITOR()
 
     } else if(data) { // Idle or Running
         update.val = std::move(data);
+        update.overrun = std::move(overrun);
 
     } else {
         // NULL update.  can this happen?
@@ -497,7 +522,11 @@ void Connection::handle_MONITOR()
                             peerName.c_str(),
                             mon->chan->name.c_str());
 
-            mon->queue.back().val.assign(update.val);
+            auto& back = mon->queue.back();
+            if(!update.overrun.empty())
+                back.overrun |= update.overrun;
+            overrunmask(back.overrun, back.val, update.val);
+            back.val.assign(update.val);
         }
 
         if(final && !update.exc) {
@@ -540,8 +569,9 @@ std::shared_ptr<Subscription> MonitorBuilder::exec()
 
     std::shared_ptr<Subscription> ret;
 
-    ctx->tcp_loop.call([&ret, this]() {
-        auto chan = Channel::build(ctx->shared_from_this(), _name);
+    auto worker = ctx->workerFor(_name);
+    worker->loop.call([&ret, this, worker]() {
+        auto chan = Channel::build(ctx->shared_from_this(), worker, _name, _server);
 
         auto op = std::make_shared<SubscriptionImpl>(Operation::Monitor, chan);
         op->event = std::move(_event);
@@ -594,7 +624,7 @@ std::shared_ptr<Subscription> MonitorBuilder::exec()
         chan->pending.push_back(op);
         chan->createOperations();
 
-        auto loop(op->chan->context->tcp_loop);
+        auto loop(op->chan->worker->loop);
         ret.reset(op.get(), [op, loop](Subscription*) mutable {
             // on user thread
             auto temp(std::move(op));
@@ -12,6 +12,7 @@
 #include <dbDefs.h>
 #include <osiSock.h>
 #include <epicsString.h>
+#include <epicsThread.h>
 
 #include <pvxs/log.h>
 #include "serverconn.h"
@@ -230,6 +231,9 @@ void Config::expand()
         auto_beacon = false;
     }
 
+    if(tcp_workers==0u)
+        tcp_workers = std::max(1, epicsThreadGetCPUs());
+
     removeDups(interfaces);
     removeDups(beaconDestinations);
 }
@@ -290,6 +294,14 @@ void _fromDefs(Config& self, const std::map<std::string, std::string>& defs, boo
         self.udp_port = 5076;
     }
 
+    if(pickone({"EPICS_PVA_SERVER_PORT"})) {
+        try {
+            self.tcp_port = parseTo<uint64_t>(pickone.val);
+        }catch(std::exception& e) {
+            log_err_printf(serversetup, "%s invalid integer : %s", pickone.name.c_str(), e.what());
+        }
+    }
+
     if(pickone({"EPICS_PVA_ADDR_LIST"})) {
         split_addr_into(pickone.name.c_str(), self.addressList, pickone.val, self.udp_port);
     }
@@ -318,6 +330,7 @@ Config& Config::applyDefs(const std::map<std::string, std::string>& defs)
 void Config::updateDefs(defs_t& defs) const
 {
     defs["EPICS_PVA_BROADCAST_PORT"] = SB()<<udp_port;
+    defs["EPICS_PVA_SERVER_PORT"] = SB()<<tcp_port;
     defs["EPICS_PVA_AUTO_ADDR_LIST"] = autoAddrList ? "YES" : "NO";
     defs["EPICS_PVA_ADDR_LIST"] = join_addr(addressList);
     defs["EPICS_PVA_INTF_ADDR_LIST"] = join_addr(interfaces);
@@ -336,6 +349,9 @@ void Config::expand()
         autoAddrList = false;
     }
 
+    if(tcp_workers==0u)
+        tcp_workers = std::max(1, epicsThreadGetCPUs());
+
     removeDups(addressList);
 }
 
@@ -358,6 +374,8 @@ std::ostream& operator<<(std::ostream& strm, const Config& conf)
 
     strm<<indent{}<<"EPICS_PVA_BROADCAST_PORT="<<conf.udp_port<<'\n';
 
+    strm<<indent{}<<"EPICS_PVA_SERVER_PORT="<<conf.tcp_port<<'\n';
+
     return strm;
 }
 
@@ -4,6 +4,8 @@
  * in file LICENSE that is included with this distribution.
  */
 
+#include <algorithm>
+
 #include <epicsAssert.h>
 
 #include <pvxs/log.h>
@@ -39,13 +41,80 @@ const char* ConnBase::peerLabel() const
 
 void ConnBase::enqueueTxBody(pva_app_msg_t cmd)
 {
-    auto tx = bufferevent_get_output(bev.get());
-    to_evbuf(tx, Header{cmd,
-                        uint8_t(isClient ? 0u : pva_flags::Server),
-                        uint32_t(evbuffer_get_length(txBody.get()))},
-             hostBE);
-    auto err = evbuffer_add_buffer(tx, txBody.get());
+    const size_t len = evbuffer_get_length(txBody.get());
+
+    if(txQueue.empty() && (!txSegSize || len <= txSegSize)) {
+        auto tx = bufferevent_get_output(bev.get());
+        to_evbuf(tx, Header{cmd,
+                            uint8_t(isClient ? 0u : pva_flags::Server),
+                            uint32_t(len)},
+                 hostBE);
+        auto err = evbuffer_add_buffer(tx, txBody.get());
+        assert(!err);
+        return;
+    }
+
+    // too long, or must wait behind a segmented message
+
+    evbuf body(evbuffer_new());
+    auto err = evbuffer_add_buffer(body.get(), txBody.get());
     assert(!err);
+
+    txQueue.emplace_back(cmd, std::move(body));
+    txQueued += len;
+
+    flushTx();
+}
+
+size_t ConnBase::txPending() const
+{
+    size_t ret = txQueued;
+    if(bev)
+        ret += evbuffer_get_length(bufferevent_get_output(bev.get()));
+    return ret;
+}
+
+void ConnBase::flushTx()
+{
+    if(!bev) {
+        txQueue.clear();
+        txQueued = 0u;
+        return;
+
+    } else if(txQueue.empty()) {
+        return;
+    }
+
+    auto tx = bufferevent_get_output(bev.get());
+
+    while(!txQueue.empty() && evbuffer_get_length(tx) < txSegSize) {
+        auto& msg = txQueue.front();
+
+        const size_t remaining = evbuffer_get_length(msg.body.get());
+        const size_t len = std::min(remaining, txSegSize);
+        const bool last = len==remaining;
+
+        uint8_t flags = isClient ? 0u : pva_flags::Server;
+        if(!msg.started && !last)
+            flags |= pva_flags::SegFirst;
+        else if(msg.started && !last)
+            flags |= pva_flags::SegMiddle;
+        else if(msg.started && last)
+            flags |= pva_flags::SegLast;
+
+        to_evbuf(tx, Header{msg.cmd, flags, uint32_t(len)}, hostBE);
+        auto n = evbuffer_remove_buffer(msg.body.get(), tx, len);
+        assert(n>=0 && size_t(n)==len);
+
+        txQueued -= len;
+        msg.started = true;
+
+        if(last)
+            txQueue.pop_front();
+    }
+
+    log_debug_printf(connio, "%s %s TX queue %zu messages, %zu bytes\n", peerLabel(), peerName.c_str(),
+                     txQueue.size(), txQueued);
 }
 
 #define CASE(Op) void ConnBase::handle_##Op() {}
@@ -91,6 +160,29 @@ void ConnBase::bevEvent(short events)
         cleanup();
 }
 
+// Called with rx holding the beginning of an incomplete message of 'total' bytes (including header).
+// Move these bytes to the beginning of a single allocation large enough for the whole message.
+// Following reads are then appended to this allocation, which evbuffer_remove_buffer()
+// later moves into segBuf without copying.
+static
+void reserveBody(evbuffer* rx, size_t total)
+{
+    const size_t have = evbuffer_get_length(rx);
+    if(have > tcp_readahead + 8u)
+        return; // not the first wakeup for this message
+
+    evbuf temp(evbuffer_new());
+    evbuffer_iovec vec{};
+    if(evbuffer_reserve_space(temp.get(), total, &vec, 1)!=1 || vec.iov_len<total)
+        return; // proceed with default allocation pattern
+
+    auto n = evbuffer_remove(rx, vec.iov_base, have);
+    assert(n>=0 && size_t(n)==have);
+    vec.iov_len = have;
+    if(evbuffer_commit_space(temp.get(), &vec, 1) || evbuffer_add_buffer(rx, temp.get()))
+        throw std::bad_alloc();
+}
+
 void ConnBase::bevRead()
 {
     // temporarily disable to bound the processing loop and ensure fairness with other connections
@@ -133,8 +225,15 @@ void ConnBase::bevRead()
             // wait for complete payload
             // and some additional if available
             size_t readahead = len;
-            if(readahead < std::numeric_limits<size_t>::max()-tcp_readahead)
+            if(len>=tcp_large_body && len < std::numeric_limits<size_t>::max()-8u) {
+                // no readahead, so that the allocation made by reserveBody()
+                // will hold exactly this message.
+                readahead = len + 8u;
+                reserveBody(rx, readahead);
+
+            } else if(readahead < std::numeric_limits<size_t>::max()-tcp_readahead) {
                 readahead += tcp_readahead;
+            }
             bufferevent_setwatermark(bev.get(), EV_READ, len, readahead);
             bufferevent_enable(bev.get(), EV_READ);
             return;
@@ -225,7 +324,10 @@ void ConnBase::bevRead()
     }
 }
 
-void ConnBase::bevWrite() {}
+void ConnBase::bevWrite()
+{
+    flushTx();
+}
 
 void ConnBase::bevEventS(struct bufferevent *bev, short events, void *ptr)
 {
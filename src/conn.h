@@ -6,6 +6,8 @@
 #ifndef CONN_H
 #define CONN_H
 
+#include <deque>
+
 #include "evhelper.h"
 #include "dataimpl.h"
 #include "utilpvt.h"
@@ -19,6 +21,11 @@ namespace impl {
 // Also bounds the loop in ConnBase::bevRead()
 constexpr size_t tcp_readahead = 0x1000u;
 
+// Message bodies of at least this length are received into a single allocation,
+// which is then handed through to decoding without copying.
+// cf. ConnBase::bevRead() and EvInBuf::adopt()
+constexpr size_t tcp_large_body = 0x10000u;
+
 /* Inactivity timeouts with PVA have a long (and growing) history.
  *
  * - Originally pvAccessCPP clients didn't send CMD_ECHO, and servers would never timeout.
@@ -47,6 +54,23 @@ struct ConnBase
     uint8_t segCmd;
     evbuf segBuf, txBody;
 
+    // Message bodies longer than this are sent as segments of at most this length.
+    // Zero disables segmentation.
+    size_t txSegSize = 0u;
+
+    struct TxMsg {
+        pva_app_msg_t cmd;
+        bool started;
+        evbuf body;
+        TxMsg(pva_app_msg_t cmd, evbuf&& body) :cmd(cmd), started(false), body(std::move(body)) {}
+    };
+    // Messages not yet moved to the bufferevent output.  Only used while a
+    // segmented message is in progress, as other messages may not be sent
+    // between its segments.
+    std::deque<TxMsg> txQueue;
+    // total body length in txQueue
+    size_t txQueued = 0u;
+
     ConnBase(bool isClient, bufferevent* bev, const SockAddr& peerAddr);
     ConnBase(const ConnBase&) = delete;
     ConnBase& operator=(const ConnBase&) = delete;
@@ -56,7 +80,14 @@ struct ConnBase
 
     void enqueueTxBody(pva_app_msg_t cmd);
 
+    // bytes not yet sent, including any waiting in txQueue
+    size_t txPending() const;
+
 protected:
+    // move (segments of) queued messages to the bufferevent output
+    // until it holds at least txSegSize bytes.
+    void flushTx();
+
 #define CASE(Op) virtual void handle_##Op();
     CASE(ECHO);
     CASE(CONNECTION_VALIDATION);
@@ -4,8 +4,13 @@
  * in file LICENSE that is included with this distribution.
  */
 
+#include <algorithm>
 #include <cstring>
+#include <vector>
+
 #include <epicsAssert.h>
+#include <epicsMutex.h>
+#include <epicsGuard.h>
 
 #include "dataimpl.h"
 #include "utilpvt.h"
@@ -91,31 +96,125 @@ Value Value::Helper::build(const void* ptr, StoreType type)
     return ret;
 }
 
+namespace impl {
+struct StructPool {
+    // enough for an update in flight, and one being processed, on a few threads
+    static constexpr size_t limit = 8u;
+
+    epicsMutex lock;
+    std::vector<StructTop*> avail;
+
+    ~StructPool() {
+        for(auto top : avail)
+            delete top;
+    }
+
+    StructTop* pop() {
+        epicsGuard<epicsMutex> G(lock);
+        StructTop* ret = nullptr;
+        if(!avail.empty()) {
+            ret = avail.back();
+            avail.pop_back();
+        }
+        return ret;
+    }
+
+    bool push(StructTop* top) {
+        epicsGuard<epicsMutex> G(lock);
+        if(avail.size() >= limit)
+            return false;
+        avail.push_back(top);
+        return true;
+    }
+};
+
+StructPoolRef::~StructPoolRef()
+{
+    delete pool.load(std::memory_order_acquire);
+}
+
+StructPool* StructPoolRef::get() const
+{
+    auto ret = pool.load(std::memory_order_acquire);
+    if(!ret) {
+        std::unique_ptr<StructPool> fresh(new StructPool);
+        if(pool.compare_exchange_strong(ret, fresh.get(), std::memory_order_acq_rel))
+            ret = fresh.release();
+        // else another thread won, and ret is its pool
+    }
+    return ret;
+}
+} // namespace impl
+
+namespace {
+// return StructTop storage to the pool of its type when the last Value reference is released
+struct StructRecycle {
+    void operator()(StructTop* top) const
+    {
+        // our reference keeps the type, and so the pool, alive until we return
+        auto desc(std::move(top->desc));
+
+        for(auto& mem : top->members) {
+            mem.deinit();
+            mem.valid = false;
+        }
+        top->enclosing.reset();
+
+        if(!desc->pool.get()->push(top))
+            delete top;
+    }
+};
+} // namespace
+
 Value::Value(const std::shared_ptr<const impl::FieldDesc>& desc)
     :desc(nullptr)
 {
     if(!desc)
         return;
 
-    auto top = std::make_shared<StructTop>();
+    auto pool = desc->pool.get();
+    auto raw = pool->pop();
+    if(raw) {
+        cnt_StructTopPoolHit.fetch_add(1u, std::memory_order_relaxed);
 
-    top->desc = desc;
-    top->members.resize(desc->size());
-    {
-        auto& root = top->members[0];
-        root.init(desc->code.storedAs());
-        root.top = top.get();
+    } else {
+        cnt_StructTopPoolMiss.fetch_add(1u, std::memory_order_relaxed);
+
+        std::unique_ptr<StructTop> fresh(new StructTop);
+        const size_t N = desc->size();
+        fresh->members.resize(N);
+
+        size_t nheavy = 0u;
+        for(size_t i=0u; i<N; i++) {
+            if(FieldStorage::isHeavy(desc.get()[i].code.storedAs()))
+                nheavy++;
+        }
+        fresh->heavy.resize(nheavy);
+
+        // assign slots once.  Kept while pooled, as the type does not change.
+        nheavy = 0u;
+        for(size_t i=0u; i<N; i++) {
+            auto& mem = fresh->members[i];
+            mem.top = fresh.get();
+            if(FieldStorage::isHeavy(desc.get()[i].code.storedAs()))
+                *reinterpret_cast<void**>(&mem.store) = &fresh->heavy[nheavy++];
+        }
+        raw = fresh.release();
     }
 
+    // members are all StoreType::Null and !valid
+    raw->members[0].init(desc->code.storedAs());
+
     if(desc->code==TypeCode::Struct) {
         for(auto& pair : desc->mlookup) {
             auto cfld = desc.get() + pair.second;
-            auto& mem = top->members.at(pair.second);
-            mem.top = top.get();
-            mem.init(cfld->code.storedAs());
+            raw->members[pair.second].init(cfld->code.storedAs());
         }
     }
 
+    raw->desc = desc;
+    std::shared_ptr<StructTop> top(raw, StructRecycle{});
+
     this->desc = desc.get();
     decltype (store) val(top, top->members.data()); // alias
     this->store = std::move(val);
@@ -160,7 +259,7 @@ Value& Value::assign(const Value& o)
         copyIn(&o, StoreType::Compound);
     } else {
         // unpack other field types
-        copyIn(o.store.get(), o.store->code);
+        copyIn(o.store->buffer(), o.store->code);
     }
     return *this;
 }
@@ -680,6 +779,11 @@ void Value::copyIn(const void *ptr, StoreType type)
                 // copy struct to struct
                 // all marked source field may be mapped to destination fields
 
+                if(src.desc==desc) {
+                    Helper::assignSame(*this, src);
+                    return;
+                }
+
                 for(const auto& sfld : src.imarked()) {
                     if(sfld.type()==TypeCode::Struct) {
                         // entire sub-struct marked.
@@ -692,7 +796,7 @@ void Value::copyIn(const void *ptr, StoreType type)
                         auto& name(src.nameOf(sfld));
                         if(auto dfld = (*this)[name]) {
                             try {
-                                dfld.copyIn(&sfld.store->store, sfld.store->code);
+                                dfld.copyIn(sfld.store->buffer(), sfld.store->code);
                             }catch(NoConvert& e){
                                 throw NoConvert(SB()<<"field \""<<name<<"\" : "<<e.what());
                             }
@@ -713,6 +817,76 @@ void Value::copyIn(const void *ptr, StoreType type)
     mark();
 }
 
+void Value::Helper::assignSame(Value& dest, const Value& src, const BitMask* mask)
+{
+    // Same FieldDesc, so storage layouts match.  Walk both in parallel
+    // instead of looking up each marked field by name.
+    // Must have the same effect as the general Struct case of copyIn()
+    auto desc = dest.desc;
+    auto sstore = src.store.get();
+    auto dstore = dest.store.get();
+    const size_t N = desc->size();
+    bool changed = false;
+    // all descendants of a marked sub-struct are copied
+    size_t cover = 0u;
+
+    for(size_t i = mask ? mask->findSet(1u) : 1u;
+        i<N;
+        i = mask ? mask->findSet(i+1u) : i+1u)
+    {
+        auto& S = sstore[i];
+        if(i>=cover && !S.valid)
+            continue;
+
+        auto& D = dstore[i];
+        auto fdesc = desc + i;
+
+        switch(D.code) {
+        case StoreType::Null: // Struct
+            if(i>=cover)
+                cover = i + fdesc->size();
+            break;
+        case StoreType::Bool:     D.as<bool>() = S.as<bool>(); break;
+        case StoreType::Integer:  D.as<int64_t>() = S.as<int64_t>(); break;
+        case StoreType::UInteger: D.as<uint64_t>() = S.as<uint64_t>(); break;
+        case StoreType::Real:     D.as<double>() = S.as<double>(); break;
+        case StoreType::String:   D.as<std::string>() = S.as<std::string>(); break;
+        case StoreType::Array: {
+            auto& sarr = S.as<shared_array<const void>>();
+            auto& darr = D.as<shared_array<const void>>();
+            if(sarr.empty())
+                darr.clear();
+            else
+                darr = sarr; // shares the array buffer
+            break;
+        }
+        case StoreType::Compound: {
+            // Union or Any.  may (re)select
+            Value dfld;
+            dfld.store = decltype(dest.store)(dest.store, &D);
+            dfld.desc = fdesc;
+            dfld.copyIn(&S.as<Value>(), StoreType::Compound);
+            break;
+        }
+        }
+        D.valid = true;
+        changed = true;
+    }
+
+    if(src.isMarked()) {
+        dest.mark();
+
+    } else if(changed) {
+        // as mark() would, for any enclosing Union/Any
+        auto top = dest.store->top;
+        std::shared_ptr<FieldStorage> enc;
+        while(top && (enc=top->enclosing.lock())) {
+            enc->valid = true;
+            top = enc->top;
+        }
+    }
+}
+
 bool Value::tryCopyIn(const void *ptr, StoreType type)
 {
     try {
@@ -770,12 +944,11 @@ void Value::traverse(const std::string &expr, bool modify, bool dothrow)
             }
 
             size_t sep = expr.find_first_of("<[-", pos);
+            size_t len = std::min(sep, expr.size()) - pos;
 
             decltype (desc->mlookup)::const_iterator it;
 
-            const auto& name = expr.substr(pos, sep-pos);
-
-            if(sep>0 && (it=desc->mlookup.find(name))!=desc->mlookup.end()) {
+            if(sep>0 && (it=desc->mlookup.find(expr.data()+pos, len))!=desc->mlookup.end()) {
                 // found it
                 auto next = desc+it->second;
                 decltype(store) value(store, store.get()+it->second);
@@ -788,7 +961,7 @@ void Value::traverse(const std::string &expr, bool modify, bool dothrow)
                 store.reset();
                 desc = nullptr;
                 if(dothrow)
-                    throw LookupError(SB()<<"no such member '"<<name<<"' in '"<<expr<<"'");
+                    throw LookupError(SB()<<"no such member '"<<expr.substr(pos, len)<<"' in '"<<expr<<"'");
             }
 
         } else if(desc->code.code==TypeCode::Union || desc->code.code==TypeCode::Any) {
@@ -811,7 +984,7 @@ void Value::traverse(const std::string &expr, bool modify, bool dothrow)
                     decltype (desc->mlookup)::const_iterator it;
                     auto& fld = store->as<Value>();
 
-                    if(sep>0 && (it=desc->mlookup.find(expr.substr(pos, sep-pos)))!=desc->mlookup.end()) {
+                    if(sep>0 && (it=desc->mlookup.find(expr.data()+pos, std::min(sep, expr.size())-pos))!=desc->mlookup.end()) {
                         // found it.
 
                         if(modify || fld.desc==&desc->members[it->second]) {
@@ -899,6 +1072,21 @@ void Value::traverse(const std::string &expr, bool modify, bool dothrow)
     }
 }
 
+FieldPath::FieldPath(const Value& base, const std::string& name)
+    :_name(name)
+{
+    auto desc = Value::Helper::desc(base);
+    if(!desc || desc->code!=TypeCode::Struct)
+        throw LookupError(SB()<<"FieldPath '"<<name<<"' requires a Struct");
+
+    auto it = desc->mlookup.find(name);
+    if(it==desc->mlookup.end())
+        throw LookupError(SB()<<"no such member '"<<name<<"'");
+
+    this->base = Value::Helper::type(base);
+    offset = it->second;
+}
+
 Value Value::operator[](const std::string& name)
 {
     Value ret(*this);
@@ -913,6 +1101,124 @@ const Value Value::operator[](const std::string& name) const
     return ret;
 }
 
+Value Value::operator[](const FieldPath& path)
+{
+    // FieldPath only names Struct members, so no Union selection on this path
+    return static_cast<const Value&>(*this)[path];
+}
+
+const Value Value::operator[](const FieldPath& path) const
+{
+    Value ret;
+    if(desc && desc==path.base.get()) {
+        decltype(store) cstore(store, store.get()+path.offset);
+        ret.store = std::move(cstore);
+        ret.desc = desc+path.offset;
+    } else if(path.base) {
+        ret = (*this)[path._name];
+    }
+    return ret;
+}
+
+namespace {
+template<typename M, typename S>
+void viewPut(FieldStorage& fld, const char* src)
+{
+    fld.as<S>() = S(*reinterpret_cast<const M*>(src));
+    fld.valid = true;
+}
+template<typename M, typename S>
+void viewGet(const FieldStorage& fld, char* dst)
+{
+    *reinterpret_cast<M*>(dst) = M(fld.as<S>());
+}
+template<typename E>
+void viewPutArr(FieldStorage& fld, const char* src)
+{
+    fld.as<shared_array<const void>>() = reinterpret_cast<const shared_array<const E>*>(src)->template castTo<const void>();
+    fld.valid = true;
+}
+template<typename E>
+void viewGetArr(const FieldStorage& fld, char* dst)
+{
+    *reinterpret_cast<shared_array<const E>*>(dst) = fld.as<shared_array<const void>>().template convertTo<const E>();
+}
+} // namespace
+
+namespace detail {
+
+StructViewBase::StructViewBase(const Value& prototype)
+    :proto(prototype.cloneEmpty())
+{
+    if(proto.type()!=TypeCode::Struct)
+        throw std::logic_error("StructView requires a Struct");
+}
+
+StructViewBase::~StructViewBase() {}
+
+void StructViewBase::_bind(const std::string& name, size_t member, TypeCode code)
+{
+    auto desc = Value::Helper::desc(proto);
+    auto it = desc->mlookup.find(name);
+    if(it==desc->mlookup.end())
+        throw LookupError(SB()<<"no such member '"<<name<<"'");
+
+    auto fcode = desc[it->second].code;
+    if(fcode!=code)
+        throw NoConvert(SB()<<"member '"<<name<<"' is "<<fcode<<", not "<<code);
+
+    Binding bind{it->second, member, nullptr, nullptr};
+
+    switch(code.code) {
+#define CASE(CODE, M, S) \
+    case TypeCode::CODE: bind.put = &viewPut<M, S>; bind.get = &viewGet<M, S>; break; \
+    case TypeCode::CODE ## A: bind.put = &viewPutArr<M>; bind.get = &viewGetArr<M>; break
+    CASE(Bool,    bool,        bool);
+    CASE(Int8,    int8_t,      int64_t);
+    CASE(Int16,   int16_t,     int64_t);
+    CASE(Int32,   int32_t,     int64_t);
+    CASE(Int64,   int64_t,     int64_t);
+    CASE(UInt8,   uint8_t,     uint64_t);
+    CASE(UInt16,  uint16_t,    uint64_t);
+    CASE(UInt32,  uint32_t,    uint64_t);
+    CASE(UInt64,  uint64_t,    uint64_t);
+    CASE(Float32, float,       double);
+    CASE(Float64, double,      double);
+    CASE(String,  std::string, std::string);
+#undef CASE
+    default:
+        throw NoConvert(SB()<<"member '"<<name<<"' of type "<<fcode<<" can not be bound");
+    }
+
+    bindings.push_back(bind);
+}
+
+void StructViewBase::_store(Value& dst, const void* src) const
+{
+    if(Value::Helper::desc(dst)!=Value::Helper::desc(proto) && !dst.equalType(proto))
+        throw std::logic_error("StructView::store() to Value of different type");
+
+    auto fields = Value::Helper::store_ptr(dst);
+    auto base = static_cast<const char*>(src);
+
+    for(auto& bind : bindings)
+        (*bind.put)(fields[bind.field], base + bind.member);
+}
+
+void StructViewBase::_load(void* dst, const Value& src) const
+{
+    if(Value::Helper::desc(src)!=Value::Helper::desc(proto) && !src.equalType(proto))
+        throw std::logic_error("StructView::load() from Value of different type");
+
+    auto fields = Value::Helper::store_ptr(src);
+    auto base = static_cast<char*>(dst);
+
+    for(auto& bind : bindings)
+        (*bind.get)(fields[bind.field], base + bind.member);
+}
+
+} // namespace detail
+
 Value Value::lookup(const std::string& name)
 {
     Value ret(*this);
@@ -1151,13 +1457,13 @@ void FieldStorage::init(StoreType code)
         as<uint64_t>() = 0u;
         return;
     case StoreType::String:
-        new(&store) std::string();
+        new(heavy()) std::string();
         return;
     case StoreType::Compound:
-        new(&store) std::shared_ptr<FieldStorage>();
+        new(heavy()) Value();
         return;
     case StoreType::Array:
-        new(&store) shared_array<void>();
+        new(heavy()) shared_array<void>();
         return;
     }
     throw std::logic_error("FieldStore::init()");
@@ -8,16 +8,21 @@
 #define DATAENCODE_H
 
 #include <cassert>
+#include <algorithm>
 
 #include <stdexcept>
 #include <functional>
 #include <ostream>
 #include <list>
 #include <map>
+#include <unordered_map>
 #include <utility>
 #include <type_traits>
 #include <memory>
 
+#include <epicsMutex.h>
+#include <epicsGuard.h>
+
 #include <pvxs/data.h>
 #include <pvxs/sharedArray.h>
 #include "pvaproto.h"
@@ -219,7 +224,34 @@ void from_wire(Buffer& buf, std::vector<FieldDesc>& descs, TypeStore& cache, uns
 }
 
 namespace {
-template<typename E, typename C = E>
+// Arrays of at least this many bytes may be referenced, instead of copied, when sent,
+// and when decoded may reference the receive buffer.
+// Smaller arrays are always copied, as bookkeeping would outweigh the savings,
+// and so as not to retain large buffers.
+constexpr size_t min_zerocopy_size = 0x10000u;
+
+// arrays of these element types have the same in-memory and wire representation,
+// up to byte order, and are copied in bulk.
+template<typename E, typename C>
+struct is_bulk : public std::integral_constant<bool, std::is_same<E, C>::value
+                                                     && std::is_arithmetic<E>::value
+                                                     && !std::is_same<E, bool>::value>
+{};
+
+// storage for a decoded array.  Every element is assigned, so trivial types are not first initialized.
+template<typename E, typename std::enable_if<std::is_trivial<E>::value, int>::type =0>
+shared_array<E> allocDecode(size_t count)
+{
+    return allocUninitialized<E>(count);
+}
+
+template<typename E, typename std::enable_if<!std::is_trivial<E>::value, int>::type =0>
+shared_array<E> allocDecode(size_t count)
+{
+    return shared_array<E>(count);
+}
+
+template<typename E, typename C = E, typename std::enable_if<!is_bulk<E, C>::value, int>::type =0>
 void to_wire(Buffer& buf, const shared_array<const void>& varr)
 {
     auto arr = varr.castTo<const E>();
@@ -229,12 +261,26 @@ void to_wire(Buffer& buf, const shared_array<const void>& varr)
     }
 }
 
-template<typename E, typename C = E>
+template<typename E, typename C = E, typename std::enable_if<is_bulk<E, C>::value, int>::type =0>
+void to_wire(Buffer& buf, const shared_array<const void>& varr)
+{
+    auto arr = varr.castTo<const E>();
+    to_wire(buf, Size{arr.size()});
+
+    const size_t nbytes = arr.size()*sizeof(E);
+    if(nbytes>=min_zerocopy_size && (sizeof(E)==1u || buf.be==hostBE)
+            && buf.reference(arr.dataPtr(), reinterpret_cast<const uint8_t*>(arr.data()), nbytes))
+        return; // wire and memory representations are identical.  Array is immutable.
+
+    to_wire_array(buf, arr.data(), arr.size());
+}
+
+template<typename E, typename C = E, typename std::enable_if<!is_bulk<E, C>::value, int>::type =0>
 void from_wire(Buffer& buf, shared_array<const void>& varr)
 {
     Size slen{};
     from_wire(buf, slen);
-    shared_array<E> arr(slen.size);
+    auto arr(allocDecode<E>(slen.size));
     for(auto i : range(arr.size())) {
         C temp{};
         from_wire(buf, temp);
@@ -242,6 +288,28 @@ void from_wire(Buffer& buf, shared_array<const void>& varr)
     }
     varr = arr.freeze().template castTo<const void>();
 }
+
+template<typename E, typename C = E, typename std::enable_if<is_bulk<E, C>::value, int>::type =0>
+void from_wire(Buffer& buf, shared_array<const void>& varr)
+{
+    Size slen{};
+    from_wire(buf, slen);
+
+    const size_t nbytes = slen.size*sizeof(E);
+    if(nbytes>=min_zerocopy_size && (sizeof(E)==1u || buf.be==hostBE)) {
+        // wire and memory representations are identical.  Reference if possible.
+        auto mem(buf.adopt(nbytes, alignof(E)));
+        if(mem) {
+            shared_array<const E> arr(mem, reinterpret_cast<const E*>(mem.get()), slen.size);
+            varr = arr.template castTo<const void>();
+            return;
+        }
+    }
+
+    auto arr(allocDecode<E>(slen.size));
+    from_wire_array(buf, arr.data(), arr.size());
+    varr = arr.freeze().template castTo<const void>();
+}
 }
 
 // serialize a field and all children (if Compound)
@@ -461,9 +529,140 @@ void to_wire_valid(Buffer& buf, const Value& val, const BitMask* mask)
 
     to_wire(buf, valid);
 
-    for(auto bit : valid.onlySet()) {
+    // a marked Struct is sent complete, and the bits of its descendants ignored.
+    // As from_wire_valid() expects.
+    for(auto bit = valid.findSet(0u);
+        bit<desc->size();)
+    {
         std::shared_ptr<const FieldStorage> cstore(store, store.get()+bit);
         to_wire_field(buf, desc+bit, cstore);
+        bit = valid.findSet(bit + desc[bit].size());
+    }
+}
+
+namespace {
+template<typename W, typename S>
+void encodeScalar(Buffer& buf, const FieldStorage& fld)
+{
+    to_wire(buf, W(fld.as<S>()));
+}
+
+void encodeBool(Buffer& buf, const FieldStorage& fld)
+{
+    to_wire(buf, uint8_t(fld.as<bool>()));
+}
+
+void encodeString(Buffer& buf, const FieldStorage& fld)
+{
+    to_wire(buf, fld.as<std::string>());
+}
+
+template<typename E, typename C = E>
+void encodeArray(Buffer& buf, const FieldStorage& fld)
+{
+    to_wire<E, C>(buf, fld.as<shared_array<const void>>());
+}
+
+EncodePlan::encode_t encoderFor(TypeCode code)
+{
+    switch(code.code) {
+    case TypeCode::Bool:     return &encodeBool;
+    case TypeCode::Int8:     return &encodeScalar<int8_t, int64_t>;
+    case TypeCode::Int16:    return &encodeScalar<int16_t, int64_t>;
+    case TypeCode::Int32:    return &encodeScalar<int32_t, int64_t>;
+    case TypeCode::Int64:    return &encodeScalar<int64_t, int64_t>;
+    case TypeCode::UInt8:    return &encodeScalar<uint8_t, uint64_t>;
+    case TypeCode::UInt16:   return &encodeScalar<uint16_t, uint64_t>;
+    case TypeCode::UInt32:   return &encodeScalar<uint32_t, uint64_t>;
+    case TypeCode::UInt64:   return &encodeScalar<uint64_t, uint64_t>;
+    case TypeCode::Float32:  return &encodeScalar<float, double>;
+    case TypeCode::Float64:  return &encodeScalar<double, double>;
+    case TypeCode::String:   return &encodeString;
+    case TypeCode::BoolA:    return &encodeArray<bool, uint8_t>;
+    case TypeCode::Int8A:    return &encodeArray<int8_t>;
+    case TypeCode::Int16A:   return &encodeArray<int16_t>;
+    case TypeCode::Int32A:   return &encodeArray<int32_t>;
+    case TypeCode::Int64A:   return &encodeArray<int64_t>;
+    case TypeCode::UInt8A:   return &encodeArray<uint8_t>;
+    case TypeCode::UInt16A:  return &encodeArray<uint16_t>;
+    case TypeCode::UInt32A:  return &encodeArray<uint32_t>;
+    case TypeCode::UInt64A:  return &encodeArray<uint64_t>;
+    case TypeCode::Float32A: return &encodeArray<float>;
+    case TypeCode::Float64A: return &encodeArray<double>;
+    case TypeCode::StringA:  return &encodeArray<std::string, const std::string&>;
+    default:                 return nullptr;
+    }
+}
+} // namespace
+
+void EncodePlan::reset(const FieldDesc* desc, const BitMask* mask)
+{
+    this->desc = desc;
+    steps.clear();
+    this->mask = BitMask();
+
+    if(!desc || desc->code!=TypeCode::Struct)
+        return;
+    assert(!mask || mask->size()==desc->size());
+
+    steps.reserve(desc->size());
+    for(auto i : range(desc->size())) {
+        auto code = desc[i].code;
+        steps.push_back(Step{encoderFor(code), code==TypeCode::Struct});
+    }
+
+    this->mask.resize(desc->size());
+    for(auto i : range(this->mask.wsize()))
+        this->mask.word(i) = mask ? mask->word(i) : ~uint64_t(0u);
+}
+
+void to_wire_valid(Buffer& buf, const Value& val, const EncodePlan& plan)
+{
+    auto desc = Value::Helper::desc(val);
+    auto store = Value::Helper::store_ptr(val);
+
+    if(!desc || desc!=plan.desc || plan.steps.empty()) {
+        to_wire_valid(buf, val, desc && plan.mask.size()==desc->size() ? &plan.mask : nullptr);
+        return;
+    }
+
+    const size_t N = plan.steps.size();
+    BitMask valid(N);
+
+    // valid && mask.  findSet() skips zero words of the mask
+    for(auto bit = plan.mask.findSet(0u);
+        bit<N;
+        bit = plan.mask.findSet(bit+1u))
+    {
+        if(store[bit].valid)
+            valid[bit] = true;
+    }
+
+    to_wire(buf, valid);
+
+    for(auto bit = valid.findSet(0u);
+        bit<N;)
+    {
+        const size_t cnt = desc[bit].size();
+        if(plan.steps[bit].isStruct) {
+            // sent complete
+            for(auto off : range(bit+1u, bit+cnt)) {
+                auto& step = plan.steps[off];
+                if(step.isStruct)
+                    continue;
+                else if(step.encode)
+                    (*step.encode)(buf, store[off]);
+                else
+                    to_wire_field(buf, desc+off, std::shared_ptr<const FieldStorage>(Value::Helper::store(val), &store[off]));
+            }
+
+        } else if(auto fn = plan.steps[bit].encode) {
+            (*fn)(buf, store[bit]);
+
+        } else {
+            to_wire_field(buf, desc+bit, std::shared_ptr<const FieldStorage>(Value::Helper::store(val), &store[bit]));
+        }
+        bit = valid.findSet(bit + cnt);
     }
 }
 
@@ -521,10 +720,10 @@ void from_wire_field(Buffer& buf, TypeStore& ctxt,  const FieldDesc* desc, const
     case StoreType::UInteger: {
         auto& fld = store->as<uint64_t>();
         switch(desc->code.code) {
-        case TypeCode::UInt8:  fld = from_wire_as<int8_t>(buf); return;
-        case TypeCode::UInt16: fld = from_wire_as<int16_t>(buf); return;
-        case TypeCode::UInt32: fld = from_wire_as<int32_t>(buf); return;
-        case TypeCode::UInt64: fld = from_wire_as<int64_t>(buf); return;
+        case TypeCode::UInt8:  fld = from_wire_as<uint8_t>(buf); return;
+        case TypeCode::UInt16: fld = from_wire_as<uint16_t>(buf); return;
+        case TypeCode::UInt32: fld = from_wire_as<uint32_t>(buf); return;
+        case TypeCode::UInt64: fld = from_wire_as<uint64_t>(buf); return;
         default: break;
         }
     }
@@ -753,15 +952,234 @@ void from_wire_valid(Buffer& buf, TypeStore& ctxt, Value& val)
     }
 }
 
+namespace {
+template<typename W, typename S>
+void decodeScalar(Buffer& buf, FieldStorage& fld)
+{
+    fld.as<S>() = S(from_wire_as<W>(buf));
+}
+
+void decodeBool(Buffer& buf, FieldStorage& fld)
+{
+    fld.as<bool>() = 0!=from_wire_as<uint8_t>(buf);
+}
+
+void decodeString(Buffer& buf, FieldStorage& fld)
+{
+    from_wire(buf, fld.as<std::string>());
+}
+
+template<typename E, typename C = E>
+void decodeArray(Buffer& buf, FieldStorage& fld)
+{
+    from_wire<E, C>(buf, fld.as<shared_array<const void>>());
+}
+
+DecodePlan::decode_t decoderFor(TypeCode code)
+{
+    switch(code.code) {
+    case TypeCode::Bool:     return &decodeBool;
+    case TypeCode::Int8:     return &decodeScalar<int8_t, int64_t>;
+    case TypeCode::Int16:    return &decodeScalar<int16_t, int64_t>;
+    case TypeCode::Int32:    return &decodeScalar<int32_t, int64_t>;
+    case TypeCode::Int64:    return &decodeScalar<int64_t, int64_t>;
+    case TypeCode::UInt8:    return &decodeScalar<uint8_t, uint64_t>;
+    case TypeCode::UInt16:   return &decodeScalar<uint16_t, uint64_t>;
+    case TypeCode::UInt32:   return &decodeScalar<uint32_t, uint64_t>;
+    case TypeCode::UInt64:   return &decodeScalar<uint64_t, uint64_t>;
+    case TypeCode::Float32:  return &decodeScalar<float, double>;
+    case TypeCode::Float64:  return &decodeScalar<double, double>;
+    case TypeCode::String:   return &decodeString;
+    case TypeCode::BoolA:    return &decodeArray<bool, uint8_t>;
+    case TypeCode::Int8A:    return &decodeArray<int8_t>;
+    case TypeCode::Int16A:   return &decodeArray<int16_t>;
+    case TypeCode::Int32A:   return &decodeArray<int32_t>;
+    case TypeCode::Int64A:   return &decodeArray<int64_t>;
+    case TypeCode::UInt8A:   return &decodeArray<uint8_t>;
+    case TypeCode::UInt16A:  return &decodeArray<uint16_t>;
+    case TypeCode::UInt32A:  return &decodeArray<uint32_t>;
+    case TypeCode::UInt64A:  return &decodeArray<uint64_t>;
+    case TypeCode::Float32A: return &decodeArray<float>;
+    case TypeCode::Float64A: return &decodeArray<double>;
+    case TypeCode::StringA:  return &decodeArray<std::string>;
+    default:                 return nullptr;
+    }
+}
+} // namespace
+
+void DecodePlan::reset(const Value& val)
+{
+    desc = Value::Helper::desc(val);
+    steps.clear();
+    lastMask = BitMask();
+    lastFields.clear();
+    lastStructs.clear();
+
+    if(!desc || desc->code!=TypeCode::Struct)
+        return;
+
+    steps.reserve(desc->size());
+    for(auto i : range(desc->size())) {
+        auto code = desc[i].code;
+        steps.push_back(Step{decoderFor(code), code==TypeCode::Struct});
+    }
+}
+
+void from_wire_valid(Buffer& buf, TypeStore& ctxt, Value& val, DecodePlan& plan)
+{
+    auto desc = Value::Helper::desc(val);
+    auto& store = Value::Helper::store(val);
+
+    if(!desc || desc!=plan.desc || plan.steps.empty()) {
+        from_wire_valid(buf, ctxt, val);
+        return;
+    }
+
+    BitMask valid;
+    from_wire(buf, valid);
+    // encoding rounds # of bits to whole bytes, so we may trim
+    valid.resize(plan.steps.size());
+    if(!buf.good())
+        return;
+
+    if(valid.size()!=plan.lastMask.size() || !(valid==plan.lastMask)) {
+        // expand as from_wire_valid() would traverse.
+        // A set Struct bit selects all of its non-Struct descendants.
+        plan.lastFields.clear();
+        plan.lastStructs.clear();
+
+        for(auto bit = valid.findSet(0u);
+            bit<plan.steps.size();)
+        {
+            const size_t cnt = desc[bit].size();
+            if(plan.steps[bit].isStruct) {
+                plan.lastStructs.push_back(bit);
+                for(auto off : range(bit+1u, bit+cnt)) {
+                    if(!plan.steps[off].isStruct)
+                        plan.lastFields.push_back(off);
+                }
+            } else {
+                plan.lastFields.push_back(bit);
+            }
+            bit = valid.findSet(bit + cnt);
+        }
+
+        plan.lastMask = std::move(valid);
+    }
+
+    auto base = store.get();
+    for(auto idx : plan.lastFields) {
+        auto& fld = base[idx];
+        if(auto fn = plan.steps[idx].decode) {
+            (*fn)(buf, fld);
+        } else {
+            std::shared_ptr<FieldStorage> cstore(store, &fld);
+            from_wire_field(buf, ctxt, desc+idx, cstore);
+        }
+        fld.valid = true;
+    }
+    for(auto idx : plan.lastStructs)
+        base[idx].valid = true;
+}
+
+namespace {
+// Hash of a complete type description, including IDs and member names.
+size_t hashType(const FieldDesc* desc, size_t count)
+{
+    std::hash<std::string> hstr;
+    size_t ret = count;
+    for(auto i : range(count)) {
+        auto& fld = desc[i];
+        ret = ret*31u + fld.code.code;
+        ret = ret*31u + hstr(fld.id);
+        for(auto& pair : fld.miter)
+            ret = ret*31u + hstr(pair.first) + pair.second;
+        if(!fld.members.empty())
+            ret = ret*31u + hashType(fld.members.data(), fld.members.size());
+    }
+    return ret;
+}
+
+// Compare complete type descriptions.  Stricter than Value::_equal(), which ignores IDs.
+bool sameType(const std::vector<FieldDesc>& A, const std::vector<FieldDesc>& B)
+{
+    if(A.size()!=B.size())
+        return false;
+
+    for(auto i : range(A.size())) {
+        if(A[i].code!=B[i].code || A[i].id!=B[i].id || A[i].miter!=B[i].miter
+                || !sameType(A[i].members, B[i].members))
+            return false;
+    }
+    return true;
+}
+
+// Process wide table of received types.  Identical types received on any
+// connection share one (immutable) FieldDesc tree.
+struct TypeIntern {
+    epicsMutex lock;
+    // hash -> types with that hash.  May contain expired entries.
+    std::unordered_map<size_t, std::vector<std::weak_ptr<const std::vector<FieldDesc>>>> byHash;
+    // remove expired entries when byHash grows to this size
+    size_t nextSweep = 64u;
+
+    std::shared_ptr<const std::vector<FieldDesc>> intern(std::shared_ptr<const std::vector<FieldDesc>>&& descs)
+    {
+        auto hash = hashType(descs->data(), descs->size());
+
+        epicsGuard<epicsMutex> G(lock);
+
+        auto& cands = byHash[hash];
+        for(auto it = cands.begin(); it!=cands.end();) {
+            if(auto cand = it->lock()) {
+                if(sameType(*cand, *descs))
+                    return cand;
+                ++it;
+            } else {
+                it = cands.erase(it);
+            }
+        }
+        cands.emplace_back(descs);
+
+        if(byHash.size() >= nextSweep) {
+            for(auto it = byHash.begin(); it!=byHash.end();) {
+                auto& vec = it->second;
+                for(auto it2 = vec.begin(); it2!=vec.end();) {
+                    if(it2->expired())
+                        it2 = vec.erase(it2);
+                    else
+                        ++it2;
+                }
+                if(vec.empty())
+                    it = byHash.erase(it);
+                else
+                    ++it;
+            }
+            nextSweep = std::max(size_t(64u), 2u*byHash.size());
+        }
+
+        return std::move(descs);
+    }
+};
+
+TypeIntern& typeIntern()
+{
+    // never destroyed, as Values may outlive static destructors
+    static TypeIntern* ti = new TypeIntern;
+    return *ti;
+}
+} // namespace
+
 void from_wire_type(Buffer& buf, TypeStore& ctxt, Value& val)
 {
-    auto descs(std::make_shared<std::vector<FieldDesc>>());
+    auto temp(std::make_shared<std::vector<FieldDesc>>());
 
-    from_wire(buf, *descs, ctxt);
+    from_wire(buf, *temp, ctxt);
     if(!buf.good())
         return;
 
-    if(!descs->empty()) {
+    if(!temp->empty()) {
+        auto descs(typeIntern().intern(std::move(temp)));
 
         std::shared_ptr<const FieldDesc> stype(descs, descs->data()); // alias
         val = Value::Helper::build(stype);
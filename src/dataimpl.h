@@ -6,7 +6,9 @@
 #ifndef DATAIMPL_H
 #define DATAIMPL_H
 
+#include <atomic>
 #include <string>
+#include <vector>
 #include <map>
 
 #include <pvxs/data.h>
@@ -37,10 +39,54 @@ struct Value::Helper {
     static inline                 const impl::FieldStorage*  store_ptr(const Value& v) { return v.store.get(); }
 
     static std::shared_ptr<const impl::FieldDesc> type(const Value& v);
+
+    /* Struct assignment between Values of identical type, ie. with the same FieldDesc.
+     * Same effect as dest.assign(src).  When a mask is given, consider only those
+     * fields, skipping unmasked fields a word at a time.  The mask must include the
+     * parents of each included field, as from request2mask().
+     */
+    static void assignSame(Value& dest, const Value& src, const BitMask* mask=nullptr);
 };
 
 namespace impl {
 struct Buffer;
+struct StructPool;
+
+// Handle for the free list of StructTop storage for Values of one FieldDesc.
+// Allocated on first use.  A copy of a FieldDesc starts with its own empty pool.
+struct StructPoolRef {
+    StructPoolRef() = default;
+    StructPoolRef(const StructPoolRef&) {}
+    StructPoolRef& operator=(const StructPoolRef&) { return *this; }
+    ~StructPoolRef();
+
+    StructPool* get() const;
+private:
+    mutable std::atomic<StructPool*> pool{nullptr};
+};
+
+// Mapping of field name to index.  Iterates in lexical order, as std::map.
+// A flat sorted vector, so that lookup is a binary search over contiguous
+// storage, and does not need a std::string key.
+struct FieldMap {
+    typedef std::pair<std::string, size_t> value_type;
+    typedef std::vector<value_type>::const_iterator const_iterator;
+    typedef const_iterator iterator;
+
+    const_iterator begin() const { return entries.begin(); }
+    const_iterator end() const { return entries.end(); }
+    size_t size() const { return entries.size(); }
+    bool empty() const { return entries.empty(); }
+
+    const_iterator find(const char* name, size_t len) const;
+    const_iterator find(const std::string& name) const { return find(name.data(), name.size()); }
+
+    // find, or insert new entry
+    size_t& operator[](const std::string& name);
+
+private:
+    std::vector<value_type> entries;
+};
 
 /** Describes a single field, leaf or otherwise, in a nested structure.
  *
@@ -59,7 +105,7 @@ struct FieldDesc {
     // "fld.sub.leaf" -> rel index
     // For Struct, relative to this (always >=1)
     // For Union, offset in members array (one entry will always be zero)
-    std::map<std::string, size_t> mlookup;
+    FieldMap mlookup;
 
     // child iteration.  child# -> ("sub", rel index in enclosing vector<FieldDesc>)
     std::vector<std::pair<std::string, size_t>> miter;
@@ -76,6 +122,9 @@ struct FieldDesc {
 
     TypeCode code{TypeCode::Null};
 
+    // recycled storage for Values with this type
+    StructPoolRef pool;
+
     // number of FieldDesc nodes which describe this node.  Inclusive.  always size()>=1
     inline size_t size() const { return 1u + (members.empty() ? mlookup.size() : 0u); }
 };
@@ -90,6 +139,12 @@ void from_wire(Buffer& buf, std::vector<FieldDesc>& descs, TypeStore& cache, uns
 
 struct StructTop;
 
+// C++ types stored in a slot of StructTop::heavy.  cf. FieldStorage::isHeavy()
+template<typename T> struct isHeavyType : std::false_type {};
+template<> struct isHeavyType<std::string> : std::true_type {};
+template<> struct isHeavyType<Value> : std::true_type {};
+template<> struct isHeavyType<shared_array<const void>> : std::true_type {};
+
 struct FieldStorage {
     /* Storage for field value.  depends on StoreType.
      *
@@ -99,13 +154,15 @@ struct FieldStorage {
      * Reals promoted to double.
      * String stored as std::string
      * Compound (Struct, Union, Any) stored as Value
+     *
+     * Scalars are stored inline.  The larger String, Compound, and Array values
+     * are stored in a slot of StructTop::heavy, and 'store' holds its address.
+     * This keeps scalar and Struct fields small.
      */
     aligned_union<8,
                        double, // Real
                        uint64_t, // Bool, Integer
-                       std::string, // String
-                       Value, // Union, Any
-                       shared_array<const void> // array of POD, std::string, or std::shared_ptr<Value>
+                       void* // String, Compound, Array
     >::type store;
     // index of this field in StructTop::members
     StructTop *top;
@@ -118,20 +175,44 @@ struct FieldStorage {
 
     size_t index() const;
 
+    // does this StoreType need a slot in StructTop::heavy
+    static constexpr bool isHeavy(StoreType code) {
+        return code==StoreType::String || code==StoreType::Compound || code==StoreType::Array;
+    }
+
     template<typename T>
-    T& as() { return *reinterpret_cast<T*>(&store); }
+    T& as() {
+        static_assert(isHeavyType<T>::value || sizeof(T)<=sizeof(store), "Not stored inline");
+        return *static_cast<T*>(isHeavyType<T>::value ? heavy() : static_cast<void*>(&store));
+    }
     template<typename T>
-    const T& as() const { return *reinterpret_cast<const T*>(&store); }
+    const T& as() const {
+        static_assert(isHeavyType<T>::value || sizeof(T)<=sizeof(store), "Not stored inline");
+        return *static_cast<const T*>(isHeavyType<T>::value ? heavy() : static_cast<const void*>(&store));
+    }
+
+    // address of stored value, as expected by Value::copyIn()
+    inline uint8_t* buffer() { return static_cast<uint8_t*>(isHeavy(code) ? heavy() : static_cast<void*>(&store)); }
+    inline const uint8_t* buffer() const { return static_cast<const uint8_t*>(isHeavy(code) ? heavy() : static_cast<const void*>(&store)); }
 
-    inline uint8_t* buffer() { return reinterpret_cast<uint8_t*>(&store); }
-    inline const uint8_t* buffer() const { return reinterpret_cast<const uint8_t*>(&store); }
+    // address of slot in StructTop::heavy
+    inline void* heavy() const { return *reinterpret_cast<void* const*>(&store); }
 };
 
+// storage for one String, Compound, or Array field
+typedef aligned_union<8,
+                      std::string, // String
+                      Value, // Union, Any
+                      shared_array<const void> // array of POD, std::string, or std::shared_ptr<Value>
+>::type HeavyStorage;
+
 // hidden (publicly) management of an allocated Struct
 struct StructTop {
     // type of first top level struct.  always !NULL.
     // Actually the first element of a vector<const FieldDesc>
     std::shared_ptr<const FieldDesc> desc;
+    // storage of String, Compound, and Array members.  Must outlive members
+    std::vector<HeavyStorage> heavy;
     // our members (inclusive).  always size()>=1
     std::vector<FieldStorage> members;
 
@@ -152,6 +233,36 @@ void to_wire_full(Buffer& buf, const Value& val);
 PVXS_API
 void to_wire_valid(Buffer& buf, const Value& val, const BitMask* mask=nullptr);
 
+/* Pre-computed to_wire_valid() for one Struct type, and one field mask.
+ * eg. for the life of a subscription with a pvRequest.
+ *
+ * Holds an encode function for each field, chosen once from its TypeCode.
+ * Only non-zero words of the field mask are visited.
+ * Const after reset(), so may be shared.
+ */
+struct EncodePlan {
+    typedef void (*encode_t)(Buffer& buf, const FieldStorage& fld);
+    struct Step {
+        // NULL for Struct, and for Union, Any, and arrays of these,
+        // which are encoded by the general path.
+        encode_t encode;
+        bool isStruct;
+    };
+    const FieldDesc* desc = nullptr;
+    std::vector<Step> steps;
+    // fields which may be sent.  All when built without a mask.
+    BitMask mask;
+
+    //! (re)build for a type, and an optional mask of fields to consider
+    PVXS_API
+    void reset(const FieldDesc* desc, const BitMask* mask=nullptr);
+};
+
+//! serialize BitMask and marked valid Value fields with an EncodePlan.
+//! Falls back to to_wire_valid() if val is not the planned type.
+PVXS_API
+void to_wire_valid(Buffer& buf, const Value& val, const EncodePlan& plan);
+
 //! deserialize type description
 PVXS_API
 void from_wire_type(Buffer& buf, TypeStore& ctxt, Value& val);
@@ -164,6 +275,42 @@ void from_wire_full(Buffer& buf, TypeStore& ctxt, Value& val);
 PVXS_API
 void from_wire_valid(Buffer& buf, TypeStore& ctxt, Value& val);
 
+/* Pre-computed from_wire_valid() for repeated updates of one Struct type.
+ * eg. for the life of a subscription.
+ *
+ * Holds a decode function for each field, chosen once from its TypeCode,
+ * and the list of fields selected by the most recent valid mask.
+ * Successive updates usually repeat the same mask.
+ * Not thread safe.
+ */
+struct DecodePlan {
+    typedef void (*decode_t)(Buffer& buf, FieldStorage& fld);
+    struct Step {
+        // NULL for Struct, and for Union, Any, and arrays of these,
+        // which are decoded by the general path.
+        decode_t decode;
+        bool isStruct;
+    };
+    const FieldDesc* desc = nullptr;
+    std::vector<Step> steps;
+
+    // most recent valid mask.  size()==0 until first decode
+    BitMask lastMask;
+    // fields to decode and mark for lastMask, in order
+    std::vector<size_t> lastFields;
+    // Struct fields to mark for lastMask
+    std::vector<size_t> lastStructs;
+
+    //! (re)build for the type of val
+    PVXS_API
+    void reset(const Value& val);
+};
+
+//! deserialize BitMask and partial Value with a DecodePlan.
+//! Falls back to from_wire_valid() if val is not the planned type.
+PVXS_API
+void from_wire_valid(Buffer& buf, TypeStore& ctxt, Value& val, DecodePlan& plan);
+
 //! deserialize type description and full value (a la. pvRequest)
 PVXS_API
 void from_wire_type_value(Buffer& buf, TypeStore& ctxt, Value& val);
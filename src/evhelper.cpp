@@ -13,7 +13,6 @@
 
 #include <cstring>
 #include <system_error>
-#include <deque>
 #include <algorithm>
 
 #include <event2/event.h>
@@ -34,8 +33,6 @@
 #include "utilpvt.h"
 #include <pvxs/log.h>
 
-typedef epicsGuard<epicsMutex> Guard;
-
 // EvInBuf prefers to extract slices of this length from a backing buffer
 static constexpr
 size_t min_slice_size = 1024u;
@@ -105,24 +102,17 @@ struct evbase::Pvt : public epicsThreadRunable
 {
     SockAttach attach;
 
-    struct Work {
-        std::function<void()> fn;
-        std::exception_ptr *result;
-        epicsEvent *notify;
-        Work(std::function<void()>&& fn, std::exception_ptr *result, epicsEvent *notify)
-            :fn(std::move(fn)), result(result), notify(notify)
-        {}
-    };
-    std::deque<Work> actions;
+    // Pending work, most recent first.  Pushed by any thread.
+    // Only taken, as a whole, by the worker.
+    std::atomic<Work*> actions{nullptr};
 
     owned_ptr<event_base> base;
     evevent keepalive;
     evevent dowork;
     epicsEvent start_sync;
-    epicsMutex lock;
 
     epicsThread worker;
-    bool running = true;
+    std::atomic<bool> running{true};
 
     INST_COUNTER(evbase);
 
@@ -143,14 +133,20 @@ struct evbase::Pvt : public epicsThreadRunable
     virtual ~Pvt()
     {
         join();
+
+        // discard work never run
+        auto work = actions.exchange(nullptr);
+        while(work) {
+            auto next = work->next;
+            if(!work->notify)
+                delete work;
+            work = next;
+        }
     }
 
     void join()
     {
-        {
-            Guard G(lock);
-            running = false;
-        }
+        running = false;
         if(worker.isCurrentThread())
             log_crit_printf(logerr, "evbase self-joining: %s\n", worker.getNameSelf());
         if(event_base_loopexit(base.get(), nullptr))
@@ -193,28 +189,51 @@ struct evbase::Pvt : public epicsThreadRunable
         }
     }
 
+    // returns true if the queue was previously empty, and the worker must be woken
+    bool push(Work* work)
+    {
+        auto head = actions.load(std::memory_order_relaxed);
+        do {
+            work->next = head;
+        } while(!actions.compare_exchange_weak(head, work,
+                                               std::memory_order_release,
+                                               std::memory_order_relaxed));
+        return !head;
+    }
+
     void doWork()
     {
-        decltype (actions) todo;
+        // take everything queued so far, and restore FIFO order
+        Work* todo = nullptr;
         {
-            Guard G(lock);
-            todo = std::move(actions);
+            auto work = actions.exchange(nullptr, std::memory_order_acquire);
+            while(work) {
+                auto next = work->next;
+                work->next = todo;
+                todo = work;
+                work = next;
+            }
         }
-        for(auto& work : todo) {
+        while(todo) {
+            auto work = todo;
+            todo = work->next;
+
             try {
-                auto fn(std::move(work.fn));
-                fn();
+                work->run();
             }catch(std::exception& e){
-                if(work.result) {
-                    Guard G(lock);
-                    *work.result = std::current_exception();
+                if(work->result) {
+                    *work->result = std::current_exception();
                 } else {
                     log_exc_printf(logerr, "Unhandled exception in event_base : %s : %s\n",
                                     typeid(e).name(), e.what());
                 }
             }
-            if(work.notify)
-                work.notify->signal();
+            if(work->notify) {
+                // owned by waiting caller
+                work->notify->signal();
+            } else {
+                delete work;
+            }
         }
     }
     static
@@ -254,47 +273,39 @@ void evbase::sync() const
     call([](){});
 }
 
-void evbase::dispatch(std::function<void()>&& fn) const
+void evbase::_dispatch(Work* work) const
 {
-    bool empty;
-    {
-        Guard G(pvt->lock);
-        if(!pvt->running)
-            throw std::logic_error("Worker stopped");
-        empty = pvt->actions.empty();
-        pvt->actions.emplace_back(std::move(fn), nullptr, nullptr);
-    }
+    std::unique_ptr<Work> temp(work);
+
+    if(!pvt->running)
+        throw std::logic_error("Worker stopped");
+
+    // only the first of a batch needs to wake the worker
+    bool empty = pvt->push(temp.release());
 
     timeval now{};
     if(empty && event_add(pvt->dowork.get(), &now))
         throw std::runtime_error("Unable to wakeup dispatch()");
 }
 
-void evbase::call(std::function<void()>&& fn) const
+void evbase::_call(Work* work) const
 {
-    if(pvt->worker.isCurrentThread()) {
-        fn();
-        return;
-    }
-
     static ThreadEvent done;
 
     std::exception_ptr result;
-    bool empty;
-    {
-        Guard G(pvt->lock);
-        if(!pvt->running)
-            throw std::logic_error("Worker stopped");
-        empty = pvt->actions.empty();
-        pvt->actions.emplace_back(std::move(fn), &result, done.get());
-    }
+    work->result = &result;
+    work->notify = done.get();
+
+    if(!pvt->running)
+        throw std::logic_error("Worker stopped");
+
+    bool empty = pvt->push(work);
 
     timeval now{};
     if(empty && event_add(pvt->dowork.get(), &now))
         throw std::runtime_error("Unable to wakeup call()");
 
     done->wait();
-    Guard G(pvt->lock);
     if(result)
         std::rethrow_exception(result);
 }
@@ -513,6 +524,10 @@ void from_wire(Buffer &buf, SockAddr& val)
 
 bool Buffer::refill(size_t more) { return false; }
 
+std::shared_ptr<const uint8_t> Buffer::adopt(size_t n, size_t align) { return nullptr; }
+
+bool Buffer::reference(const std::shared_ptr<const void>& owner, const uint8_t* p, size_t n) { return false; }
+
 FixedBuf::~FixedBuf() {}
 
 VectorOutBuf::~VectorOutBuf() {}
@@ -562,6 +577,27 @@ bool EvOutBuf::refill(size_t more)
     return true;
 }
 
+static
+void releaseReference(const void *data, size_t datalen, void *extra)
+{
+    delete static_cast<std::shared_ptr<const void>*>(extra);
+}
+
+bool EvOutBuf::reference(const std::shared_ptr<const void>& owner, const uint8_t* p, size_t n)
+{
+    // commit what has been written so far, so that the reference follows it
+    if(!refill(0))
+        return false;
+
+    std::unique_ptr<std::shared_ptr<const void>> holder(new std::shared_ptr<const void>(owner));
+
+    if(evbuffer_add_reference(backing, p, n, &releaseReference, holder.get()))
+        return false;
+
+    holder.release(); // now owned by backing
+    return true;
+}
+
 EvInBuf::~EvInBuf() { refill(0); }
 
 bool EvInBuf::refill(size_t needed)
@@ -573,6 +609,8 @@ bool EvInBuf::refill(size_t needed)
         throw std::bad_alloc();
 
     limit = base = pos = nullptr;
+    // the next slice may be a copy made by pullup()
+    pinned.reset();
 
     if(needed) {
         // expand request in an attempt to reduce the number of refill()s
@@ -606,6 +644,49 @@ bool EvInBuf::refill(size_t needed)
     return true;
 }
 
+std::shared_ptr<const uint8_t> EvInBuf::adopt(size_t n, size_t align)
+{
+#if LIBEVENT_VERSION_NUMBER < 0x02010000
+    // no evbuffer_add_buffer_reference()
+    return nullptr;
+#else
+    if(err || n>size() || (reinterpret_cast<size_t>(pos)%align))
+        return nullptr;
+
+    if(!pinned) {
+        // consume up to pos so that the current slice begins with the bytes being adopted
+        if(evbuffer_drain(backing, pos-base))
+            throw std::bad_alloc();
+        base = pos;
+
+        std::shared_ptr<evbuffer> temp(evbuffer_new(), evbuffer_free);
+        if(!temp)
+            throw std::bad_alloc();
+        // last reference may be released from any thread.
+        // fails, harmlessly, if libevent threading support is not enabled.
+        (void)evbuffer_enable_locking(temp.get(), nullptr);
+
+        // move, not copy, all chains.  So [base, limit) remains valid
+        if(evbuffer_add_buffer(temp.get(), backing))
+            throw std::bad_alloc();
+
+        // backing continues with a read-only reference to the same memory.
+        if(evbuffer_add_buffer_reference(backing, temp.get())) {
+            // not possible.  eg. backing already contained references.  Put back
+            if(evbuffer_add_buffer(backing, temp.get()))
+                throw std::bad_alloc();
+            return nullptr;
+        }
+
+        pinned = std::move(temp);
+    }
+
+    std::shared_ptr<const uint8_t> ret(pinned, pos);
+    pos += n;
+    return ret;
+#endif
+}
+
 void to_evbuf(evbuffer *buf, const Header& H, bool be)
 {
     EvOutBuf M(be, buf, 8);
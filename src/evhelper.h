@@ -11,12 +11,16 @@
 #include <functional>
 #include <memory>
 #include <string>
+#include <exception>
+#include <type_traits>
 
 #include <event2/event.h>
 #include <event2/buffer.h>
 #include <event2/listener.h>
 #include <event2/bufferevent.h>
 
+#include <epicsEvent.h>
+
 #include <pvxs/version.h>
 #include <utilpvt.h>
 
@@ -70,10 +74,22 @@ struct PVXS_API evbase {
     void sync() const;
 
     // queue request to execute in event loop.  return immediately.
-    void dispatch(std::function<void()>&& fn) const;
+    template<typename Fn>
+    void dispatch(Fn&& fn) const {
+        _dispatch(new WorkFn<typename std::decay<Fn>::type>(std::forward<Fn>(fn)));
+    }
 
     // queue request to execute in event loop.  return after executed.
-    void call(std::function<void()>&& fn) const;
+    template<typename Fn>
+    void call(Fn&& fn) const {
+        if(inLoop()) {
+            fn();
+            return;
+        }
+        // caller waits, so the work item need not outlive this frame
+        WorkFn<typename std::decay<Fn>::type> work(std::forward<Fn>(fn));
+        _call(&work);
+    }
 
     void assertInLoop() const;
     bool inLoop() const;
@@ -81,6 +97,31 @@ struct PVXS_API evbase {
     inline void reset() { pvt.reset(); }
 
 private:
+    // Entry in the lock-free queue of pending work.
+    // The callable is stored inline, so queuing allocates at most once.
+    struct Work {
+        Work* next = nullptr;
+        std::exception_ptr *result = nullptr;
+        epicsEvent *notify = nullptr;
+        virtual ~Work() {}
+        // runs, then destroys, the callable
+        virtual void run() =0;
+    };
+    template<typename Fn>
+    struct WorkFn final : public Work {
+        Fn fn;
+        explicit WorkFn(Fn&& fn) :fn(std::move(fn)) {}
+        explicit WorkFn(const Fn& fn) :fn(fn) {}
+        virtual ~WorkFn() {}
+        virtual void run() override final {
+            auto temp(std::move(fn));
+            temp();
+        }
+    };
+
+    void _dispatch(Work* work) const;
+    void _call(Work* work) const;
+
     struct Pvt;
     std::shared_ptr<Pvt> pvt;
 public:
@@ -6,6 +6,8 @@
 
 #include <pvxs/nt.h>
 
+#include "utilpvt.h"
+
 namespace pvxs {
 namespace nt {
 
@@ -145,6 +147,91 @@ TypeDef NTNDArray::build() const
     return def;
 }
 
+NTTable& NTTable::addColumn(TypeCode code, const std::string& name, const std::string& label)
+{
+    if(!code.valid() || !code.isarray() || code.kind()==Kind::Compound)
+        throw std::logic_error("NTTable column must be an array of primative");
+
+    _cols.push_back(Column{code, name, label.empty() ? name : label});
+    return *this;
+}
+
+TypeDef NTTable::build() const
+{
+    using namespace pvxs::members;
+
+    std::vector<Member> cols;
+    cols.reserve(_cols.size());
+    for(auto& col : _cols)
+        cols.emplace_back(col.code, col.name);
+
+    TypeDef def(TypeCode::Struct, "epics:nt/NTTable:1.0", {
+                    StringA("labels"),
+                    Struct("value", cols),
+                    String("descriptor"),
+                    Struct("alarm", "alarm_t", {
+                        Int32("severity"),
+                        Int32("status"),
+                        String("message"),
+                    }),
+                    Struct("timeStamp", "time_t", {
+                        Int64("secondsPastEpoch"),
+                        Int32("nanoseconds"),
+                        Int32("userTag"),
+                    }),
+                });
+
+    return def;
+}
+
+Value NTTable::create() const
+{
+    auto ret(build().create());
+
+    shared_array<std::string> labels(_cols.size());
+    for(size_t i=0u; i<_cols.size(); i++)
+        labels[i] = _cols[i].label;
+    ret["labels"] = labels.freeze();
+
+    return ret;
+}
+
+NTTableColumns::NTTableColumns(const Value& prototype)
+{
+    auto value(prototype["value"]);
+    if(value.type()!=TypeCode::Struct)
+        throw LookupError("NTTable has no Struct \"value\"");
+
+    for(auto col : value.ichildren()) {
+        auto& name = value.nameOf(col);
+        if(!col.type().isarray() || col.type().kind()==Kind::Compound)
+            throw std::logic_error(SB()<<"NTTable column \""<<name<<"\" is not an array of primative");
+
+        _names.push_back(name);
+        _paths.emplace_back(prototype, "value."+name);
+    }
+}
+
+size_t NTTableColumns::index(const std::string& name) const
+{
+    for(size_t i=0u; i<_names.size(); i++) {
+        if(_names[i]==name)
+            return i;
+    }
+    throw LookupError(SB()<<"NTTable has no column \""<<name<<"\"");
+}
+
+size_t NTTableColumns::rows(const Value& table) const
+{
+    size_t ret = 0u;
+    for(size_t i=0u; i<_paths.size(); i++) {
+        auto len = table[_paths[i]].as<shared_array<const void>>().size();
+        if(i==0u || len<ret)
+            ret = len;
+    }
+    return ret;
+}
+
 NTURI::NTURI(std::initializer_list<Member> args)
 {
     using namespace pvxs::members;
@@ -10,8 +10,10 @@
 #include <compilerDependencies.h>
 #include <cstdint>
 #include <cstring>
+#include <algorithm>
 #include <vector>
 #include <string>
+#include <memory>
 #include <type_traits>
 #include <initializer_list>
 
@@ -89,6 +91,17 @@ public:
 
     uint8_t* save() const { return pos; }
     void restore(uint8_t* p) { pos = p; }
+
+    // Attempt to reference the next n bytes in place, instead of copying them out.
+    // Returns NULL if not possible.  eg. if the bytes are not contiguous, or the
+    // first byte is not aligned to a multiple of 'align'.  On success the n bytes
+    // are consumed, and remain valid for the lifetime of the returned reference.
+    virtual std::shared_ptr<const uint8_t> adopt(size_t n, size_t align);
+
+    // Attempt to append the n bytes at p by reference, instead of copying them in.
+    // 'owner' is retained until these bytes are no longer needed.
+    // Returns false if not possible, in which case the caller should copy.
+    virtual bool reference(const std::shared_ptr<const void>& owner, const uint8_t* p, size_t n);
 };
 
 //! (de)serialization to/from buffers which are fixed size and contigious
@@ -138,6 +151,7 @@ public:
     {refill(isize);}
     virtual ~EvOutBuf();
     virtual bool refill(size_t more) override final;
+    virtual bool reference(const std::shared_ptr<const void>& owner, const uint8_t* p, size_t n) override final;
 };
 
 //! deserialize from an evbuffer, possibly segmented
@@ -146,6 +160,8 @@ class PVXS_API EvInBuf : public Buffer
     typedef Buffer base_type;
     evbuffer * const backing;
     uint8_t* base; // original pos after ctor or refill()
+    // after adopt(), holds the memory of the current slice.  Reset by refill()
+    std::shared_ptr<evbuffer> pinned;
 public:
 
     EvInBuf(bool be, evbuffer *b, size_t ifill=0)
@@ -156,6 +172,7 @@ public:
     virtual ~EvInBuf();
 
     virtual bool refill(size_t more) override final;
+    virtual std::shared_ptr<const uint8_t> adopt(size_t n, size_t align) override final;
 };
 
 // assumes prior buf.ensure(M) where M>=N
@@ -199,6 +216,120 @@ inline void _from_wire(Buffer& buf, uint8_t *mem, bool reverse)
     buf._skip(N);
 }
 
+namespace idetail {
+// byte order reversal of a single element.  Spelled out for the benefit of the optimizer,
+// which recognizes these (and loops of them) as bswap instructions and vectorizes accordingly.
+EPICS_ALWAYS_INLINE uint16_t bswap(uint16_t v) {
+    return uint16_t((v>>8u) | (v<<8u));
+}
+EPICS_ALWAYS_INLINE uint32_t bswap(uint32_t v) {
+#if defined(__GNUC__)
+    return __builtin_bswap32(v);
+#else
+    return (v>>24u) | ((v>>8u)&0x0000ff00u) | ((v<<8u)&0x00ff0000u) | (v<<24u);
+#endif
+}
+EPICS_ALWAYS_INLINE uint64_t bswap(uint64_t v) {
+#if defined(__GNUC__)
+    return __builtin_bswap64(v);
+#else
+    return (uint64_t(bswap(uint32_t(v)))<<32u) | bswap(uint32_t(v>>32u));
+#endif
+}
+
+template<unsigned N> struct uintN;
+template<> struct uintN<2> { typedef uint16_t type; };
+template<> struct uintN<4> { typedef uint32_t type; };
+template<> struct uintN<8> { typedef uint64_t type; };
+
+// copy count elements of N bytes, reversing byte order of each.
+// dst and src must not overlap.  No alignment requirement.
+template<unsigned N>
+inline void copy_swapped(uint8_t *dst, const uint8_t *src, size_t count)
+{
+    typedef typename uintN<N>::type U;
+    for(size_t i=0; i<count; i++) {
+        U v;
+        memcpy(&v, src + i*N, N);
+        v = bswap(v);
+        memcpy(dst + i*N, &v, N);
+    }
+}
+template<>
+inline void copy_swapped<1u>(uint8_t *dst, const uint8_t *src, size_t count)
+{
+    memcpy(dst, src, count);
+}
+} // namespace idetail
+
+/** Write an array of count elements, each of N bytes.
+ *
+ * Space for all remaining elements is requested up front, with fall back to
+ * filling whatever the buffer provides.  Each contiguous slice is then filled
+ * with a single memcpy(), or a byte reversing copy when byte order differs.
+ */
+template<unsigned N>
+void _to_wire_array(Buffer& buf, const uint8_t *mem, size_t count, bool reverse)
+{
+    while(count) {
+        if(!buf.ensure(count*N) && !buf.ensure(N)) {
+            buf.fault(__FILE__, __LINE__);
+            return;
+        }
+        size_t n = std::min(count, buf.size()/N);
+
+        if(reverse)
+            idetail::copy_swapped<N>(buf.save(), mem, n);
+        else
+            memcpy(buf.save(), mem, n*N);
+
+        buf._skip(n*N);
+        mem += n*N;
+        count -= n;
+    }
+}
+
+/** Read an array of count elements, each of N bytes.
+ *
+ * Only asks for one element at a time so as not to force the backing buffer
+ * to be made contiguous (eg. evbuffer_pullup() ).  Copies as many whole
+ * elements as the current slice provides.
+ */
+template<unsigned N>
+void _from_wire_array(Buffer& buf, uint8_t *mem, size_t count, bool reverse)
+{
+    while(count) {
+        if(!buf.ensure(N)) {
+            buf.fault(__FILE__, __LINE__);
+            return;
+        }
+        size_t n = std::min(count, buf.size()/N);
+
+        if(reverse)
+            idetail::copy_swapped<N>(mem, buf.save(), n);
+        else
+            memcpy(mem, buf.save(), n*N);
+
+        buf._skip(n*N);
+        mem += n*N;
+        count -= n;
+    }
+}
+
+//! Serialize array of arithmetic type (excluding bool)
+template<typename T, typename std::enable_if<std::is_arithmetic<T>::value && !std::is_same<T, bool>::value, int>::type =0>
+inline void to_wire_array(Buffer& buf, const T* arr, size_t count)
+{
+    _to_wire_array<sizeof(T)>(buf, reinterpret_cast<const uint8_t*>(arr), count, sizeof(T)>1 && (buf.be ^ hostBE));
+}
+
+//! Deserialize array of arithmetic type (excluding bool)
+template<typename T, typename std::enable_if<std::is_arithmetic<T>::value && !std::is_same<T, bool>::value, int>::type =0>
+inline void from_wire_array(Buffer& buf, T* arr, size_t count)
+{
+    _from_wire_array<sizeof(T)>(buf, reinterpret_cast<uint8_t*>(arr), count, sizeof(T)>1 && (buf.be ^ hostBE));
+}
+
 /** Write sizeof(T) bytes from buf from val
  *
  * @param buf output buffer.  buf[0] through buf[sizeof(T)-1] must be valid.
@@ -435,6 +566,7 @@ struct pva_flags {
         SegNone = 0x00,
         SegFirst= 0x10,
         SegLast = 0x20,
+        SegMiddle=0x30,
         SegMask = 0x30,
         Server = 0x40,
         MSB = 0x80,
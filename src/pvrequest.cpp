@@ -4,6 +4,8 @@
  * in file LICENSE that is included with this distribution.
  */
 
+#include <algorithm>
+
 #include "pvrequest.h"
 #include "dataimpl.h"
 
@@ -92,4 +94,30 @@ bool testmask(const Value& update, const BitMask& mask)
     return false;
 }
 
+void overrunmask(BitMask& overrun, const Value& queued, const Value& update, const BitMask* mask)
+{
+    auto desc = Value::Helper::desc(update);
+    auto qstore = Value::Helper::store_ptr(queued);
+    auto ustore = Value::Helper::store_ptr(update);
+
+    if(!desc || desc!=Value::Helper::desc(queued))
+        return;
+
+    if(overrun.size()!=desc->size())
+        overrun.resize(desc->size());
+
+    // fields below these indices are marked through an enclosing Struct
+    size_t qend = 0u, uend = 0u;
+
+    for(auto idx : range(desc->size())) {
+        if(qstore[idx].valid)
+            qend = std::max(qend, idx + desc[idx].size());
+        if(ustore[idx].valid)
+            uend = std::max(uend, idx + desc[idx].size());
+
+        if(idx<qend && idx<uend && (!mask || (*mask)[idx]))
+            overrun[idx] = true;
+    }
+}
+
 }} // namespace pvxs::impl
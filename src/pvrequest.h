@@ -19,6 +19,12 @@ BitMask request2mask(const FieldDesc* desc, const Value& pvRequest);
 PVXS_API
 bool testmask(const Value& update, const BitMask& mask);
 
+//! Mark in overrun those fields of update which are also marked in queued.
+//! ie. those fields which will be overwritten when update is squashed into queued.
+//! Optionally limited to fields in mask.  overrun is resized if necessary.
+PVXS_API
+void overrunmask(BitMask& overrun, const Value& queued, const Value& update, const BitMask* mask=nullptr);
+
 }} // namespace pvxs::impl
 
 #endif // PVREQUEST_H
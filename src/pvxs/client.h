@@ -189,6 +189,17 @@ public:
      * @endcode
      */
     virtual Value pop() =0;
+
+    /** De-queue update from subscription event queue, as with pop().
+     *
+     *  Also report which fields of a data update were overrun.
+     *  That is, those fields which changed more than once, with intermediate
+     *  values discarded by the server or client queue.
+     *  A field is overrun if @code overrun["fld"].isMarked() @endcode
+     *
+     *  overrun is set to an empty/invalid Value unless a data update is returned.
+     */
+    virtual Value pop(Value& overrun) =0;
 };
 
 class GetBuilder;
@@ -423,6 +434,24 @@ public:
      */
     void cacheClear();
 
+    //! UDP search traffic since this Context was created.
+    //! @since UNRELEASED
+    struct SearchStats {
+        //! search requests sent, and the send system calls which sent them
+        uint64_t txPackets, txSyscalls;
+        //! search replies received, and the receive system calls which received them
+        uint64_t rxPackets, rxSyscalls;
+    };
+
+    /** Counters of UDP search traffic.
+     *
+     *  Requests and replies are batched, so fewer system calls than packets
+     *  indicates that batching is effective.
+     *
+     *  @since UNRELEASED
+     */
+    SearchStats searchStats() const;
+
     explicit operator bool() const { return pvt.operator bool(); }
     size_t use_count() const { return pvt.use_count(); }
 private:
@@ -512,6 +541,12 @@ public:
     SubBuilder& rawRequest(const Value& r) { this->_rawRequest(r); return _sb(); }
 
     SubBuilder& priority(int p) { this->_prio = p; return _sb(); }
+    /** Connect directly to the server at "host[:port]", without searching.
+     *  Port defaults to Config::tcp_port.  eg. to reach the "server" PV, which is not advertised.
+     *  While the server is not reachable, a connection is attempted once per second.
+     *
+     *  exec() throws std::runtime_error if the address can not be parsed.
+     */
     SubBuilder& server(const std::string& s) { this->_server = s; return _sb(); }
 };
 
@@ -712,6 +747,31 @@ struct PVXS_API Config {
     unsigned short udp_port = 5076;
     //! Whether to extend the addressList with local interface broadcast addresses.  (recommended)
     bool autoAddrList = true;
+    //! Default TCP port of servers, used with CommonBuilder::server().  Default is 5075.
+    unsigned short tcp_port = 5075;
+
+    /** Number of threads handling TCP connections.  Default is one.
+     *  Zero selects one per CPU core.
+     *
+     *  Channels are divided between threads by PV name.  Each thread
+     *  opens its own connection to a server, and decodes all replies
+     *  for its Channels.
+     */
+    unsigned tcp_workers = 1u;
+
+    /** Maximum length of a message sent to a server, in bytes.
+     *  Longer messages, eg. a PUT of a large array, are split into segments.
+     *  Default zero disables segmentation.
+     */
+    unsigned tcp_segment_size = 0u;
+
+    /** Maximum rate of search requests sent, in datagrams per second.
+     *  Each search packet counts once for each address in the addressList.
+     *  Default zero is unlimited.
+     *
+     *  Channels which would exceed this rate are searched on the next tick.
+     */
+    double search_max_rate = 0.0;
 
     // compat
     static inline Config from_env() { return Config{}.applyEnv(); }
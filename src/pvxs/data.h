@@ -461,6 +461,42 @@ struct PVXS_API LookupError : public std::runtime_error
     virtual ~LookupError();
 };
 
+/** Location of a descendant field of a Struct, resolved once by name.
+ *
+ * For repeated access to the same field of many Values of one type.
+ * Applying a FieldPath to a Value of the type it was resolved
+ * against takes constant time, with no string handling.
+ * With any other type, it falls back to lookup by name.
+ *
+ * @code
+ * auto prototype = nt::NTScalar{TypeCode::Int32}.create();
+ * FieldPath sevr(prototype, "alarm.severity");
+ * for(...) {
+ *     auto update = prototype.cloneEmpty();
+ *     update[sevr] = 1;
+ *     ...
+ * }
+ * @endcode
+ */
+class PVXS_API FieldPath {
+    friend class Value;
+    std::shared_ptr<const impl::FieldDesc> base;
+    size_t offset = 0u;
+    std::string _name;
+public:
+    //! An empty path, which selects no field
+    FieldPath() = default;
+    /** Resolve a name within base.
+     *
+     * @param base A Struct
+     * @param name name of a descendant field.  eg. "value" or "alarm.severity"
+     * @throws LookupError if base is not a Struct, or has no such field.
+     */
+    FieldPath(const Value& base, const std::string& name);
+
+    inline const std::string& name() const { return _name; }
+};
+
 /** Generic data container
  *
  * References a single data field, which may be free-standing (eg. "int x = 5;")
@@ -517,6 +553,8 @@ public:
     //! copy value(s) from other.
     //! Acts like from(o) for kind==Kind::Compound .
     //! Acts like from(o.as<T>()) for kind!=Kind::Compound
+    //! For a Struct, only marked fields of other are copied, so assign() merges a partial update.
+    //! Fastest when both have exactly the same type, eg. other was created with cloneEmpty().
     Value& assign(const Value& o);
 
     //! Use to allocate members for an array of Struct and array of Union
@@ -688,6 +726,11 @@ public:
     Value operator[](const std::string& name);
     const Value operator[](const std::string& name) const;
 
+    //! Access a descendant field through a pre-resolved path.
+    //! Equivalent to @code (*this)[path.name()] @endcode
+    Value operator[](const FieldPath& path);
+    const Value operator[](const FieldPath& path) const;
+
     /** Attempt to access a descendant field, or throw exception.
      *
      * Acts like operator[] on success, but throws a (hopefully descriptive)
@@ -889,6 +932,91 @@ std::ostream& operator<<(std::ostream& strm, const Value& val)
     return strm<<val.format();
 }
 
+namespace detail {
+//! Type independent part of StructView
+class PVXS_API StructViewBase {
+    struct Binding {
+        size_t field;  // offset of field in StructTop
+        size_t member; // byte offset of member in user struct
+        void (*put)(impl::FieldStorage& fld, const char* src);
+        void (*get)(const impl::FieldStorage& fld, char* dst);
+    };
+    Value proto;
+    std::vector<Binding> bindings;
+protected:
+    explicit StructViewBase(const Value& prototype);
+    ~StructViewBase();
+
+    void _bind(const std::string& name, size_t member, TypeCode code);
+    void _store(Value& dst, const void* src) const;
+    void _load(void* dst, const Value& src) const;
+};
+
+template<typename M>
+struct ViewCode {
+    static TypeCode code() { return impl::ScalarMap<M>::code; }
+};
+template<typename E>
+struct ViewCode<shared_array<const E>> {
+    static TypeCode code() { return TypeCode(impl::ScalarMap<typename std::remove_cv<E>::type>::code).arrayOf(); }
+};
+} // namespace detail
+
+/** Binds members of a C++ struct to fields of one Struct type.
+ *
+ * Field names and types are checked once, by bind().
+ * store() and load() then copy all bound members to/from a Value
+ * of that type, by offset and without conversion.
+ *
+ * Members may be bool, a fixed width integer, float, double, std::string,
+ * or shared_array<const E> of one of these.
+ * A member type must exactly match the type of its field.  eg. int32_t for TypeCode::Int32 .
+ *
+ * @code
+ * struct Sample {
+ *     double value;
+ *     int32_t severity;
+ *     int64_t sec;
+ * };
+ * auto prototype = nt::NTScalar{TypeCode::Float64}.create();
+ * StructView<Sample> view(prototype);
+ * view.bind("value", &Sample::value)
+ *     .bind("alarm.severity", &Sample::severity)
+ *     .bind("timeStamp.secondsPastEpoch", &Sample::sec);
+ *
+ * Sample sample{1.0, 0, 1234};
+ * auto update = prototype.cloneEmpty();
+ * view.store(update, sample); // marks bound fields
+ * @endcode
+ */
+template<typename T>
+class StructView : private detail::StructViewBase {
+public:
+    //! Binding to fields of Values with the same type as prototype.
+    //! eg. prototype.cloneEmpty()
+    explicit StructView(const Value& prototype) :StructViewBase(prototype) {}
+
+    /** Bind a member to a named field.
+     *
+     * @throws LookupError if there is no such field
+     * @throws NoConvert if the field type is not exactly that of the member
+     */
+    template<typename M>
+    StructView& bind(const std::string& name, M T::* member) {
+        const T temp{};
+        auto offset = size_t(reinterpret_cast<const char*>(&(temp.*member)) - reinterpret_cast<const char*>(&temp));
+        _bind(name, offset, detail::ViewCode<M>::code());
+        return *this;
+    }
+
+    //! Copy all bound members into, and mark, fields of dst.
+    //! @throws std::logic_error if dst is not of the prototype type.
+    void store(Value& dst, const T& src) const { _store(dst, &src); }
+    //! Copy all bound fields of src into members of dst.
+    //! @throws std::logic_error if src is not of the prototype type.
+    void load(T& dst, const Value& src) const { _load(&dst, src); }
+};
+
 } // namespace pvxs
 
 #endif // PVXS_DATA_H
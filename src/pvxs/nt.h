@@ -73,6 +73,106 @@ struct NTNDArray {
     }
 };
 
+/** A table of named columns.  Each column is an array of primitive type,
+ * and all columns have the same length.
+ *
+ * @code
+ * auto def = pvxs::nt::NTTable{}
+ *                 .addColumn(TypeCode::Int32A, "index", "Index")
+ *                 .addColumn(TypeCode::Float64A, "position", "Position");
+ * auto value = def.create(); // instantiate a Value, with "labels" filled in
+ * @endcode
+ *
+ * Use NTTableColumns to read or write whole columns.
+ */
+class PVXS_API NTTable {
+    struct Column {
+        TypeCode code;
+        std::string name;
+        std::string label;
+    };
+    std::vector<Column> _cols;
+public:
+    /** Append a column.
+     *
+     * @param code Array of primitive type.  eg. TypeCode::Float64A
+     * @param name Name of the column field, a member of "value".
+     * @param label Human readable column title.  Default is name.
+     * @throws std::logic_error if code is not an array of primitive type.
+     */
+    NTTable& addColumn(TypeCode code, const std::string& name, const std::string& label=std::string());
+
+    //! A TypeDef which can be appended
+    TypeDef build() const;
+
+    //! Instantiate, with "labels" filled in
+    Value create() const;
+};
+
+/** Whole column access to NTTable Values.  Columns are looked up once, by name.
+ *
+ * Columns are read and written as complete arrays.
+ * This does not copy when the array element type is that of the column.
+ * eg. shared_array<const double> for TypeCode::Float64A .
+ *
+ * @code
+ * auto prototype = nt::NTTable{}.addColumn(TypeCode::Float64A, "position").create();
+ * nt::NTTableColumns cols(prototype);
+ * const auto position = cols.index("position");
+ *
+ * shared_array<double> arr(50000);
+ * // fill in arr ...
+ * auto update = prototype.cloneEmpty();
+ * cols.set(update, position, arr.freeze()); // marks "value.position"
+ *
+ * auto readback = cols.get<double>(update, position);
+ * @endcode
+ */
+class PVXS_API NTTableColumns {
+    std::vector<std::string> _names;
+    std::vector<FieldPath> _paths;
+public:
+    /** Find columns of an NTTable
+     *
+     * @param prototype A Value with a Struct field "value" of array members.
+     *        eg. from NTTable::create()
+     * @throws LookupError if prototype has no Struct "value".
+     * @throws std::logic_error if a member of "value" is not an array.
+     */
+    explicit NTTableColumns(const Value& prototype);
+
+    //! Number of columns
+    inline size_t size() const { return _names.size(); }
+
+    //! Name of a column.  eg. "position" for field "value.position".
+    inline const std::string& name(size_t col) const { return _names.at(col); }
+
+    //! Index of a column, by name
+    //! @throws LookupError if there is no such column.
+    size_t index(const std::string& name) const;
+
+    /** Replace, and mark, a column.
+     *
+     * @throws NoConvert if the element type of arr is not the column type.
+     */
+    template<typename E>
+    void set(Value& table, size_t col, const shared_array<const E>& arr) const {
+        table[_paths.at(col)] = arr;
+    }
+
+    /** Current contents of a column.
+     *
+     * Returns a reference when E is the column type, and a converted copy otherwise.
+     */
+    template<typename E>
+    shared_array<const E> get(const Value& table, size_t col) const {
+        return table[_paths.at(col)].as<shared_array<const E>>();
+    }
+
+    //! Number of rows, which is the length of the shortest column.
+    size_t rows(const Value& table) const;
+};
+
 class PVXS_API NTURI {
     TypeDef _def;
 public:
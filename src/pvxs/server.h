@@ -143,6 +143,45 @@ struct PVXS_API Config {
     unsigned short udp_port = 5076;
     //! Whether to populate the beacon address list automatically.  (recommended)
     bool auto_beacon = true;
+    /** Number of threads handling TCP connections.  Default is one.
+     *  Zero selects one per CPU core.
+     *
+     *  Each new connection is assigned to the thread with the fewest connections,
+     *  which then handles all traffic of that connection.
+     */
+    unsigned tcp_workers = 1u;
+
+    /** Maximum length of a message sent to a client, in bytes.
+     *  Longer messages are split into segments.  Default zero disables segmentation.
+     *
+     *  Segments are only queued for sending as earlier ones are sent,
+     *  which bounds the memory buffered for each connection.
+     *  Other messages are queued until the last segment is sent.
+     */
+    unsigned tcp_segment_size = 0u;
+
+    /** Answer searches from an index of the names listed by Sources
+     *  with a non-dynamic Source::onList(), eg. StaticSource.
+     *  Those Sources are then no longer asked through Source::onSearch(),
+     *  and other Sources are only asked about names not found in the index.
+     *
+     *  Only enable if each such Source claims exactly the names it lists.
+     *  Source::onList() of every Source is called for each search request
+     *  to detect changes.  Any change rebuilds the index.
+     */
+    bool claim_index = false;
+
+    /** Remember up to this many recently searched names which no Source claimed.
+     *  Repeated searches for these names are then answered without asking any Source.
+     *  Default zero disables.
+     *
+     *  All entries are forgotten when a Source is added or removed,
+     *  or when any Source::onList() returns a different list.
+     *  Otherwise each entry expires after search_miss_timeout seconds.
+     */
+    unsigned search_miss_cache = 0u;
+    //! Lifetime in seconds of entries in the search_miss_cache.
+    double search_miss_timeout = 5.0;
 
     //! Server unique ID.  Only meaningful in readback via Server::config()
     std::array<uint8_t, 12> guid{};
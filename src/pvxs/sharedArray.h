@@ -9,6 +9,7 @@
 #include <cstddef>
 #include <cstdint>
 #include <memory>
+#include <new>
 #include <type_traits>
 #include <algorithm>
 #include <ostream>
@@ -92,6 +93,21 @@ struct sa_default_delete {
     void operator()(E* e) const { delete[] e; }
 };
 
+//! Alignment of storage from allocUninitialized().  Suits SIMD loads and stores up to 512 bits.
+constexpr size_t sa_alignment = 64u;
+
+//! Allocate nbytes aligned to sa_alignment.  Never returns NULL.  Free with alignedFree()
+//! @throws std::bad_alloc
+PVXS_API
+void* alignedAlloc(size_t nbytes);
+PVXS_API
+void alignedFree(void* ptr);
+
+template<typename E>
+struct sa_aligned_delete {
+    void operator()(E* e) const { alignedFree((void*)e); }
+};
+
 template<typename E>
 struct sa_base {
 protected:
@@ -677,6 +693,33 @@ public:
     }
 };
 
+/** Allocate an array of count elements without initializing them.
+ *
+ * Storage is aligned to at least 64 bytes.
+ * For an array which will be completely overwritten,
+ * this avoids the cost of first filling it.
+ * E must be a trivial type.  eg. bool, a fixed width integer, float, or double.
+ *
+ * @code
+ *   auto arr(allocUninitialized<double>(1024u));
+ *   for(size_t i=0u; i<arr.size(); i++)
+ *       arr[i] = ...; // every element must be assigned before reading
+ *   shared_array<const double> carr(arr.freeze());
+ * @endcode
+ */
+template<typename E>
+shared_array<E> allocUninitialized(size_t count)
+{
+    static_assert(std::is_trivial<E>::value && !std::is_const<E>::value,
+                  "allocUninitialized() requires a non-const trivial element type");
+    if(count==0u)
+        return shared_array<E>();
+    if(count > size_t(-1)/sizeof(E))
+        throw std::bad_alloc();
+    auto raw = static_cast<E*>(detail::alignedAlloc(count*sizeof(E)));
+    return shared_array<E>(raw, detail::sa_aligned_delete<E>(), count);
+}
+
 // non-const -> const
 template <typename SRC>
 static inline
@@ -51,6 +51,10 @@ struct MonitorStat {
     //! serialized and in the TX buffer.
     size_t nQueue, limitQueue;
 
+    //! Number of updates combined with an un-sent update, instead of being queued.
+    //! Fields overwritten in this way are reported to the client as overrun.
+    size_t nSquash;
+
     bool running;
     bool finished;
     bool pipeline;
@@ -225,10 +229,27 @@ struct PVXS_API Source {
 
     //! List of channel names
     struct List {
-        //! The list
+        /** The list.
+         *
+         *  Return a different list after any change to the names this Source may claim.
+         *  A Server with Config::claim_index or Config::search_miss_cache compares
+         *  successive lists to detect changes.
+         */
         std::shared_ptr<const std::set<std::string>> names;
         //! True if the list may change at some future time.
         bool dynamic;
+        /** Change counter.  If non-zero, must be incremented after any change to names.
+         *  A Server then compares counters instead of lists.
+         *  @since UNRELEASED
+         */
+        uint64_t version;
+
+        List() :dynamic(false), version(0u) {}
+        List(const std::shared_ptr<const std::set<std::string>>& names,
+             bool dynamic=false,
+             uint64_t version=0u)
+            :names(names), dynamic(dynamic), version(version)
+        {}
     };
 
     /** A Client is requesting a list of Channel names which we may claim.
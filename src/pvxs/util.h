@@ -105,7 +105,9 @@ public:
 
 #endif // !defined(__rtems__) && !defined(vxWorks)
 
-//! return a snapshot of internal instance counters
+//! return a snapshot of internal instance counters.
+//! Also includes the running totals StructTopPoolHit and StructTopPoolMiss,
+//! counting Value allocations which did, or did not, reuse pooled storage.
 PVXS_API
 std::map<std::string, size_t> instanceSnapshot();
 
@@ -12,6 +12,7 @@
 #include <functional>
 #include <atomic>
 #include <cstdlib>
+#include <cstring>
 
 #include <signal.h>
 
@@ -150,6 +151,7 @@ client::Config Server::clientConfig() const
 
     client::Config ret;
     ret.udp_port = pvt->effective.udp_port;
+    ret.tcp_port = pvt->effective.tcp_port;
     ret.interfaces = pvt->effective.interfaces;
     ret.addressList = pvt->effective.interfaces;
     ret.autoAddrList = false;
@@ -249,7 +251,7 @@ std::ostream& operator<<(std::ostream& strm, const Server& serv)
         if(detail<2)
             return strm;
 
-        serv.pvt->acceptor_loop.call([&serv, &strm, detail](){
+        serv.pvt->acceptor_loop.call([&serv, &strm](){
             strm<<indent{}<<"State: ";
             switch(serv.pvt->state) {
 #define CASE(STATE) case Server::Pvt::STATE: strm<< #STATE; break
@@ -260,56 +262,60 @@ std::ostream& operator<<(std::ostream& strm, const Server& serv)
 #undef CASE
             }
             strm<<"\n";
+        });
 
-            Indented I(strm);
+        Indented I(strm);
 
-            for(auto& pair : serv.pvt->connections) {
-                auto conn = pair.first;
+        for(auto& worker : serv.pvt->workers) {
+            worker->loop.call([&worker, &strm, detail](){
+                for(auto& pair : worker->connections) {
+                    auto conn = pair.first;
 
-                strm<<indent{}<<"Peer"<<conn->peerName
-                    <<" backlog="<<conn->backlog.size()
-                    <<" auth="<<conn->autoMethod<<"\n";
-                if(detail>2)
-                    strm<<conn->credentials;
+                    strm<<indent{}<<"Peer"<<conn->peerName
+                        <<" backlog="<<conn->backlog.size()
+                        <<" auth="<<conn->autoMethod<<"\n";
+                    if(detail>2)
+                        strm<<conn->credentials;
 
-                if(detail<=2)
-                    continue;
+                    if(detail<=2)
+                        continue;
 
-                Indented I(strm);
+                    Indented I(strm);
 
-                for(auto& pair : conn->chanBySID) {
-                    auto& chan = pair.second;
-                    strm<<indent{}<<chan->name<<' ';
+                    for(auto& pair : conn->chanBySID) {
+                        auto& chan = pair.second;
+                        strm<<indent{}<<chan->name<<' ';
 
-                    if(chan->state==ServerChan::Creating) {
-                        strm<<"CREATING sid="<<chan->sid<<" cid="<<chan->cid<<"\n";
-                    } else if(chan->state==ServerChan::Destroy) {
-                        strm<<"DESTROY  sid="<<chan->sid<<" cid="<<chan->cid<<"\n";
-                    } else if(chan->opByIOID.empty()) {
-                        strm<<"IDLE     sid="<<chan->sid<<" cid="<<chan->cid<<"\n";
-                    }
+                        if(chan->state==ServerChan::Creating) {
+                            strm<<"CREATING sid="<<chan->sid<<" cid="<<chan->cid<<"\n";
+                        } else if(chan->state==ServerChan::Destroy) {
+                            strm<<"DESTROY  sid="<<chan->sid<<" cid="<<chan->cid<<"\n";
+                        } else if(chan->opByIOID.empty()) {
+                            strm<<"IDLE     sid="<<chan->sid<<" cid="<<chan->cid<<"\n";
+                        }
 
-                    for(auto& pair : chan->opByIOID) {
-                        auto& op = pair.second;
-                        if(!op) {
-                            strm<<"NULL ioid="<<pair.first<<"\n";
-                        } else {
-                            strm<<indent{};
-                            switch (op->state) {
+                        for(auto& pair : chan->opByIOID) {
+                            auto& op = pair.second;
+                            if(!op) {
+                                strm<<"NULL ioid="<<pair.first<<"\n";
+                            } else {
+                                strm<<indent{};
+                                switch (op->state) {
 #define CASE(STATE) case ServerOp::STATE: strm<< #STATE; break
-                            CASE(Creating);
-                            CASE(Idle);
-                            CASE(Executing);
-                            CASE(Dead);
+                                CASE(Creating);
+                                CASE(Idle);
+                                CASE(Executing);
+                                CASE(Dead);
 #undef CASE
+                                }
+                                strm<<" ioid="<<pair.first<<" ";
+                                op->show(strm);
                             }
-                            strm<<" ioid="<<pair.first<<" ";
-                            op->show(strm);
                         }
                     }
                 }
-            }
-        });
+            });
+        }
     }
 
     return strm;
@@ -327,6 +333,17 @@ Server::Pvt::Pvt(const Config &conf)
 {
     effective.expand();
 
+    if(effective.tcp_workers<=1u) {
+        workers.emplace_back(new ServerWorker(acceptor_loop));
+
+    } else {
+        workers.reserve(effective.tcp_workers);
+        for(auto i : range(effective.tcp_workers)) {
+            evbase loop(SB()<<"PVXTCP"<<i, epicsThreadPriorityCAServerLow-2);
+            workers.emplace_back(new ServerWorker(loop));
+        }
+    }
+
     {
         int val = 1;
         if(setsockopt(beaconSender.sock, SOL_SOCKET, SO_BROADCAST, (char *)&val, sizeof(val)))
@@ -501,17 +518,40 @@ void Server::Pvt::stop()
             log_debug_printf(serversetup, "Server disabled listener on %s\n", iface.name.c_str());
         }
 
-        // close current TCP connections
-        auto conns = std::move(connections);
-        for(auto& pair : conns) {
-            pair.second->bev.reset();
-            pair.second->cleanup();
-        }
+    });
+
+    for(auto& worker : workers) {
+        worker->loop.call([&worker]()
+        {
+            // close current TCP connections
+            auto conns = std::move(worker->connections);
+            for(auto& pair : conns) {
+                pair.second->bev.reset();
+                pair.second->cleanup();
+            }
+        });
+    }
 
+    acceptor_loop.call([this]()
+    {
         state = Stopped;
     });
 }
 
+ServerWorker* Server::Pvt::pickWorker()
+{
+    ServerWorker* best = nullptr;
+    size_t bestcnt = 0u;
+    for(auto& worker : workers) {
+        size_t cnt = worker->nconn.load();
+        if(!best || cnt < bestcnt) {
+            best = worker.get();
+            bestcnt = cnt;
+        }
+    }
+    return best;
+}
+
 void Server::Pvt::onSearch(const UDPManager::Search& msg)
 {
     // on UDPManager worker
@@ -527,13 +567,67 @@ void Server::Pvt::onSearch(const UDPManager::Search& msg)
 
     {
         auto G(sourcesLock.lockReader());
-        for(const auto& pair : sources) {
+
+        auto ask = [](const sources_t::value_type& pair, Source::Search& op) {
             try {
-                pair.second->onSearch(searchOp);
+                pair.second->onSearch(op);
             }catch(std::exception& e){
                 log_exc_printf(serversetup, "Unhandled error in Source::onSearch for '%s' : %s\n",
                            pair.first.second.c_str(), e.what());
             }
+        };
+
+        if(!effective.claim_index && !effective.search_miss_cache) {
+            for(const auto& pair : sources) {
+                ask(pair, searchOp);
+            }
+
+        } else {
+            if(claimIndex.refresh(sources, effective.claim_index))
+                missCache.clear();
+
+            epicsTime now;
+            if(effective.search_miss_cache)
+                now = epicsTime::getCurrent();
+
+            searchAsk._names.clear();
+            searchAskIdx.clear();
+
+            for(auto i : range(searchOp._names.size())) {
+                auto& name = searchOp._names[i];
+                claimIndex.key.assign(name._name);
+
+                if(effective.claim_index && claimIndex.names.find(claimIndex.key)!=claimIndex.names.end()) {
+                    name._claim = true;
+
+                } else if(!effective.search_miss_cache || !missCache.lookup(claimIndex.key, now)) {
+                    searchAsk._names.push_back(name);
+                    searchAskIdx.push_back(i);
+                }
+            }
+
+            // fall back to Sources not in the index, only for names not already known
+            if(!searchAsk._names.empty()) {
+                memcpy(searchAsk._src, searchOp._src, sizeof(searchAsk._src));
+
+                size_t i = 0u;
+                for(const auto& pair : sources) {
+                    if(!effective.claim_index || !claimIndex.entries[i].indexed)
+                        ask(pair, searchAsk);
+                    i++;
+                }
+
+                const auto expires(now + effective.search_miss_timeout);
+                for(auto j : range(searchAsk._names.size())) {
+                    const auto& name = searchAsk._names[j];
+                    if(name._claim) {
+                        searchOp._names[searchAskIdx[j]]._claim = true;
+
+                    } else if(effective.search_miss_cache) {
+                        missCache.insert(name._name, expires, effective.search_miss_cache);
+                    }
+                }
+            }
         }
     }
 
@@ -580,6 +674,120 @@ void Server::Pvt::onSearch(const UDPManager::Search& msg)
     }
 }
 
+namespace {
+// true if a and b refer to the same object.  Not fooled by re-use of an address.
+template<typename A, typename B>
+bool sameOwner(const std::weak_ptr<A>& a, const std::shared_ptr<B>& b)
+{
+    return !a.owner_before(b) && !b.owner_before(a);
+}
+} // namespace
+
+bool Server::Pvt::ClaimIndex::refresh(const sources_t& sources, bool build)
+{
+    lists.clear();
+    lists.reserve(sources.size());
+
+    // index must be rebuilt
+    bool stale = entries.size()!=sources.size();
+    // some list has changed, maybe only of a dynamic Source
+    bool changed = stale;
+    size_t nnames = 0u;
+
+    for(const auto& pair : sources) {
+        try {
+            lists.push_back(pair.second->onList());
+        }catch(std::exception& e){
+            log_exc_printf(serversetup, "Unhandled error in Source::onList for '%s' : %s\n",
+                           pair.first.second.c_str(), e.what());
+            lists.push_back(Source::List{nullptr, true});
+        }
+        const auto& L = lists.back();
+        const bool indexed = !L.dynamic && L.names;
+        if(indexed)
+            nnames += L.names->size();
+
+        if(!stale) {
+            const auto& E = entries[lists.size()-1u];
+            // prefer change counter.  identity also true when both are null
+            const bool samelist = L.version ? E.version==L.version : sameOwner(E.list, L.names);
+            stale = !sameOwner(E.src, pair.second)
+                    || E.indexed!=indexed
+                    || (indexed && !samelist);
+            changed |= stale || !samelist;
+        }
+    }
+
+    if(changed) {
+        entries.clear();
+
+        size_t i = 0u;
+        for(const auto& pair : sources) {
+            const auto& L = lists[i++];
+            entries.push_back(Entry{pair.second, L.names, L.version, !L.dynamic && L.names});
+        }
+    }
+
+    if(stale && build) {
+        names.clear();
+        names.reserve(nnames);
+
+        for(const auto& L : lists) {
+            if(!L.dynamic && L.names)
+                names.insert(L.names->begin(), L.names->end());
+        }
+
+        log_debug_printf(serversetup, "Rebuilt claim index with %zu names\n", names.size());
+    }
+
+    // release our references
+    lists.clear();
+
+    return changed;
+}
+
+bool Server::Pvt::MissCache::lookup(const std::string& name, const epicsTime& now)
+{
+    auto it(names.find(name));
+    if(it!=names.end()) {
+        if(now < it->second->first) {
+            nhit.fetch_add(1u, std::memory_order_relaxed);
+            return true;
+        }
+        // expired
+        order.erase(it->second);
+        names.erase(it);
+        nsize.store(names.size(), std::memory_order_relaxed);
+    }
+    nmiss.fetch_add(1u, std::memory_order_relaxed);
+    return false;
+}
+
+void Server::Pvt::MissCache::insert(const std::string& name, const epicsTime& expires, size_t limit)
+{
+    auto pos(names.emplace(name, order.end()));
+    if(!pos.second)
+        return; // already cached.  eg. repeated in one request
+
+    pos.first->second = order.emplace(order.end(), expires, &pos.first->first);
+
+    // evict oldest
+    while(names.size() > limit) {
+        names.erase(*order.front().second);
+        order.pop_front();
+    }
+    nsize.store(names.size(), std::memory_order_relaxed);
+}
+
+void Server::Pvt::MissCache::clear()
+{
+    if(!names.empty())
+        log_debug_printf(serversetup, "Clear %zu cached search misses\n", names.size());
+    order.clear();
+    names.clear();
+    nsize.store(0u, std::memory_order_relaxed);
+}
+
 void Server::Pvt::doBeacons(short evt)
 {
     log_debug_printf(serversetup, "Server beacon timer expires\n%s", "");
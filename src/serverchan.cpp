@@ -37,6 +37,7 @@ ServerChan::~ServerChan() {
 
 ServerChannelControl::ServerChannelControl(const std::shared_ptr<ServerConn> &conn, const std::shared_ptr<ServerChan>& channel)
     :server(conn->iface->server->internal_self)
+    ,worker(conn->worker)
     ,chan(channel)
 {
     _op = None;
@@ -53,7 +54,7 @@ void ServerChannelControl::onOp(std::function<void(std::unique_ptr<server::Conne
     if(!serv)
         return;
 
-    serv->acceptor_loop.call([this, &fn](){
+    worker->loop.call([this, &fn](){
         auto ch = chan.lock();
         if(!ch)
             return;
@@ -68,7 +69,7 @@ void ServerChannelControl::onRPC(std::function<void(std::unique_ptr<server::Exec
     if(!serv)
         return;
 
-    serv->acceptor_loop.call([this, &fn](){
+    worker->loop.call([this, &fn](){
         auto ch = chan.lock();
         if(!ch)
             return;
@@ -83,7 +84,7 @@ void ServerChannelControl::onSubscribe(std::function<void(std::unique_ptr<server
     if(!serv)
         return;
 
-    serv->acceptor_loop.call([this, &fn](){
+    worker->loop.call([this, &fn](){
         auto ch = chan.lock();
         if(!ch)
             return;
@@ -98,7 +99,7 @@ void ServerChannelControl::onClose(std::function<void(const std::string&)>&& fn)
     if(!serv)
         return;
 
-    serv->acceptor_loop.call([this, &fn](){
+    worker->loop.call([this, &fn](){
         auto ch = chan.lock();
         if(!ch || ch->state==ServerChan::Destroy)
             return;
@@ -153,19 +154,21 @@ void ServerChannelControl::close()
     if(!serv)
         return;
 
-    serv->acceptor_loop.call([this](){
+    worker->loop.call([this](){
         auto ch = chan.lock();
         if(!ch)
             return;
         auto conn = ch->conn.lock();
-        if(conn && ch->state==ServerChan::Active) {
+        if(conn && conn->bev && ch->state==ServerChan::Active) {
             // Send unsolicited Channel Destroy
 
-            auto tx = bufferevent_get_output(conn->bev.get());
-            EvOutBuf R(hostBE, tx);
-            to_wire(R, Header{CMD_DESTROY_CHANNEL, pva_flags::Server, 8});
-            to_wire(R, ch->sid);
-            to_wire(R, ch->cid);
+            (void)evbuffer_drain(conn->txBody.get(), evbuffer_get_length(conn->txBody.get()));
+            {
+                EvOutBuf R(hostBE, conn->txBody.get());
+                to_wire(R, ch->sid);
+                to_wire(R, ch->cid);
+            }
+            conn->enqueueTxBody(CMD_DESTROY_CHANNEL);
         }
         ServerChannel_shutdown(ch);
     });
@@ -176,7 +179,7 @@ std::pair<std::string, Value> ServerChannelControl::rawCredentials() const
     std::pair<std::string, Value> ret;
     auto serv = server.lock();
     if(serv)
-        serv->acceptor_loop.call([this, &ret](){
+        worker->loop.call([this, &ret](){
             if(auto chan = this->chan.lock())
                 if(auto conn = chan->conn.lock())
                     ret = std::make_pair(conn->autoMethod, conn->credentials.clone());
@@ -394,16 +397,13 @@ void ServerConn::handle_DESTROY_CHANNEL()
     assert(chan.use_count()==1); // we only take transient refs on this thread
     // ServerChannel is delete'd
 
+    (void)evbuffer_drain(txBody.get(), evbuffer_get_length(txBody.get()));
     {
-        auto tx = bufferevent_get_output(bev.get());
-        EvOutBuf R(hostBE, tx);
-        to_wire(R, Header{CMD_DESTROY_CHANNEL, pva_flags::Server, 8});
+        EvOutBuf R(hostBE, txBody.get());
         to_wire(R, sid);
         to_wire(R, cid);
-
-        if(!R.good())
-            bev.reset();
     }
+    enqueueTxBody(CMD_DESTROY_CHANNEL);
 }
 
 }} // namespace pvxs::impl
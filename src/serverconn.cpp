@@ -27,11 +27,12 @@ DEFINE_LOGGER(connio, "pvxs.tcp.io");
 
 DEFINE_LOGGER(remote, "pvxs.remote.log");
 
-ServerConn::ServerConn(ServIface* iface, evutil_socket_t sock, struct sockaddr *peer, int socklen)
+ServerConn::ServerConn(ServIface* iface, ServerWorker* worker, evutil_socket_t sock, const SockAddr& peer)
     :ConnBase(false,
-              bufferevent_socket_new(iface->server->acceptor_loop.base, sock, BEV_OPT_CLOSE_ON_FREE|BEV_OPT_DEFER_CALLBACKS),
-              SockAddr(peer, socklen))
+              bufferevent_socket_new(worker->loop.base, sock, BEV_OPT_CLOSE_ON_FREE|BEV_OPT_DEFER_CALLBACKS),
+              peer)
     ,iface(iface)
+    ,worker(worker)
 {
     log_debug_printf(connio, "Client %s connects\n", peerName.c_str());
 
@@ -39,6 +40,8 @@ ServerConn::ServerConn(ServIface* iface, evutil_socket_t sock, struct sockaddr *
 
     bufferevent_set_timeouts(bev.get(), &tcp_timeout, &tcp_timeout);
 
+    txSegSize = iface->server->effective.tcp_segment_size;
+
     auto tx = bufferevent_get_output(bev.get());
 
     std::vector<uint8_t> buf(128);
@@ -75,7 +78,9 @@ ServerConn::ServerConn(ServIface* iface, evutil_socket_t sock, struct sockaddr *
 }
 
 ServerConn::~ServerConn()
-{}
+{
+    worker->nconn--;
+}
 
 const std::shared_ptr<ServerChan>& ServerConn::lookupSID(uint32_t sid)
 {
@@ -92,14 +97,13 @@ void ServerConn::handle_ECHO()
 {
     // Client requests echo as a keep-alive check
 
-    auto tx = bufferevent_get_output(bev.get());
-    uint32_t len = evbuffer_get_length(segBuf.get());
-
-    to_evbuf(tx, Header{CMD_ECHO, pva_flags::Server, len}, hostBE);
-
-    auto err = evbuffer_add_buffer(tx, segBuf.get());
+    // reply with the same body.  queued behind any segmented message in progress
+    (void)evbuffer_drain(txBody.get(), evbuffer_get_length(txBody.get()));
+    auto err = evbuffer_add_buffer(txBody.get(), segBuf.get());
     assert(!err);
 
+    enqueueTxBody(CMD_ECHO);
+
     // maybe help reduce latency
     bufferevent_flush(bev.get(), EV_WRITE, BEV_FLUSH);
 }
@@ -282,7 +286,7 @@ void ServerConn::cleanup()
 {
     log_debug_printf(connsetup, "Client %s Cleanup TCP Connection\n", peerName.c_str());
 
-    iface->server->connections.erase(this);
+    worker->connections.erase(this);
 
     for(auto& pair : opByIOID) {
         if(pair.second->onClose)
@@ -302,9 +306,7 @@ void ServerConn::bevRead()
     ConnBase::bevRead();
 
     if(bev) {
-        auto tx = bufferevent_get_output(bev.get());
-
-        if(evbuffer_get_length(tx)>=tcp_tx_limit) {
+        if(txPending()>=tcp_tx_limit) {
             // write buffer "full".  stop reading until it drains
             // TODO configure
             (void)bufferevent_disable(bev.get(), EV_READ);
@@ -318,10 +320,12 @@ void ServerConn::bevWrite()
 {
     log_debug_printf(connio, "%s process backlog\n", peerName.c_str());
 
-    auto tx = bufferevent_get_output(bev.get());
+    // continue any segmented message
+    ConnBase::bevWrite();
+
     // handle pending monitors
 
-    while(!backlog.empty() && evbuffer_get_length(tx)<tcp_tx_limit) {
+    while(!backlog.empty() && txPending()<tcp_tx_limit) {
         auto fn = std::move(backlog.front());
         backlog.pop_front();
 
@@ -329,7 +333,7 @@ void ServerConn::bevWrite()
     }
 
     // TODO configure
-    if(evbuffer_get_length(tx)<tcp_tx_limit) {
+    if(txPending()<tcp_tx_limit) {
         (void)bufferevent_enable(bev.get(), EV_READ);
         bufferevent_setwatermark(bev.get(), EV_WRITE, 0, 0);
         log_debug_printf(connio, "%s resume READ\n", peerName.c_str());
@@ -344,6 +348,10 @@ ServIface::ServIface(const std::string& addr, unsigned short port, server::Serve
 {
     server->acceptor_loop.assertInLoop();
 
+    // a restarted server may re-bind its port while connections of the
+    // previous instance linger in TIME_WAIT.  (no-op on Windows)
+    evutil_make_listen_socket_reuseable(sock.sock);
+
     // try to bind to requested port, then fallback to a random port
     while(true) {
         try {
@@ -381,8 +389,28 @@ void ServIface::onConnS(struct evconnlistener *listener, evutil_socket_t sock, s
             evutil_closesocket(sock);
             return;
         }
-        auto conn(std::make_shared<ServerConn>(self, sock, peer, socklen));
-        self->server->connections[conn.get()] = std::move(conn);
+        SockAddr peerAddr(peer, socklen);
+
+        auto worker = self->server->pickWorker();
+        worker->nconn++;
+        try {
+            // connection state is only accessed from the assigned worker
+            worker->loop.dispatch([self, worker, sock, peerAddr]() {
+                std::shared_ptr<ServerConn> conn;
+                try {
+                    conn = std::make_shared<ServerConn>(self, worker, sock, peerAddr);
+                }catch(std::exception& e){
+                    log_exc_printf(connsetup, "Interface %s Unhandled error in accept: %s\n", self->name.c_str(), e.what());
+                    worker->nconn--;
+                    evutil_closesocket(sock);
+                    return;
+                }
+                worker->connections[conn.get()] = std::move(conn);
+            });
+        }catch(...){
+            worker->nconn--;
+            throw;
+        }
     }catch(std::exception& e){
         log_exc_printf(connsetup, "Interface %s Unhandled error in accept callback: %s\n", self->name.c_str(), e.what());
         evutil_closesocket(sock);
@@ -9,10 +9,15 @@
 
 #include <list>
 #include <map>
+#include <set>
+#include <unordered_set>
+#include <unordered_map>
+#include <deque>
 #include <memory>
 #include <atomic>
 
 #include <epicsEvent.h>
+#include <epicsTime.h>
 
 #include <pvxs/server.h>
 #include <pvxs/source.h>
@@ -28,6 +33,7 @@ namespace pvxs {namespace impl {
 struct ServIface;
 struct ServerConn;
 struct ServerChan;
+struct ServerWorker;
 
 // base for tracking in-progress operations.  cf. ServerConn::opByIOID and ServerChan::opByIOID
 struct ServerOp
@@ -69,6 +75,8 @@ struct ServerChannelControl : public server::ChannelControl
     virtual std::pair<std::string, Value> rawCredentials() const override final;
 
     const std::weak_ptr<server::Server::Pvt> server;
+    // valid while server is alive
+    ServerWorker* const worker;
     const std::weak_ptr<ServerChan> chan;
 
     INST_COUNTER(ServerChannelControl);
@@ -102,9 +110,54 @@ struct ServerChan
     ~ServerChan();
 };
 
+/* Recently encoded monitor updates.  cf. MonitorOp::doReply()
+ *
+ * When one Value is posted to many subscriptions (eg. by SharedPV)
+ * those with the same pvRequest mask share a single serialization.
+ * Only accessed from the loop of the owning ServerWorker.
+ */
+struct UpdateCache
+{
+    struct Entry {
+        // weak so that the cache does not prolong the life of a posted Value.
+        // While !expired(), 'ptr' identifies the same instance.
+        std::weak_ptr<const FieldStorage> val;
+        const FieldStorage* ptr = nullptr;
+        BitMask mask;
+        bool be = false;
+        evbuf body; // BitMask and valid fields
+    };
+    std::deque<Entry> entries; // oldest first
+
+    // maximum number of entries
+    static constexpr size_t limit = 16u;
+
+    // append serialization of changed fields of val, as filtered by plan.mask, to buf.
+    // @pre val is not modified after being posted
+    void encode(evbuffer* buf, const Value& val, const EncodePlan& plan, bool be);
+};
+
+// An event loop handling some of the TCP connections of a Server.
+// All state of a ServerConn, including its channels and operations,
+// is only accessed from the loop of the ServerWorker to which it is assigned.
+struct ServerWorker
+{
+    evbase loop;
+
+    // only accessed from loop worker
+    std::map<ServerConn*, std::shared_ptr<ServerConn> > connections;
+    UpdateCache updateCache;
+
+    // number of connections assigned to this worker.  cf. ServIface::onConnS()
+    std::atomic<size_t> nconn{0u};
+
+    explicit ServerWorker(const evbase& loop) :loop(loop) {}
+};
+
 struct ServerConn : public ConnBase, public std::enable_shared_from_this<ServerConn>
 {
     ServIface* const iface;
+    ServerWorker* const worker;
 
     std::string autoMethod;
     Value credentials;
@@ -117,7 +170,7 @@ struct ServerConn : public ConnBase, public std::enable_shared_from_this<ServerC
 
     INST_COUNTER(ServerConn);
 
-    ServerConn(ServIface* iface, evutil_socket_t sock, struct sockaddr *peer, int socklen);
+    ServerConn(ServIface* iface, ServerWorker* worker, evutil_socket_t sock, const SockAddr& peer);
     ServerConn(const ServerConn&) = delete;
     ServerConn& operator=(const ServerConn&) = delete;
     ~ServerConn();
@@ -215,11 +268,14 @@ struct Server::Pvt
     // accept new connections and send beacons
     evbase acceptor_loop;
 
+    // handle TCP connections.  Size is at least one.
+    // With only one, the acceptor_loop is shared.
+    std::vector<std::unique_ptr<ServerWorker>> workers;
+
     std::list<std::unique_ptr<UDPListener> > listeners;
     std::vector<SockAddr> beaconDest;
 
     std::list<ServIface> interfaces;
-    std::map<ServerConn*, std::shared_ptr<ServerConn> > connections;
 
     evsocket beaconSender;
     evevent beaconTimer;
@@ -231,7 +287,52 @@ struct Server::Pvt
     StaticSource builtinsrc;
 
     RWLock sourcesLock;
-    std::map<std::pair<int, std::string>, std::shared_ptr<Source> > sources;
+    typedef std::map<std::pair<int, std::string>, std::shared_ptr<Source> > sources_t;
+    sources_t sources;
+
+    // names listed by non-dynamic Sources.  cf. Config::claim_index
+    // only accessed from onSearch()
+    struct ClaimIndex {
+        struct Entry {
+            std::weak_ptr<Source> src;
+            // last list returned by onList()
+            std::weak_ptr<const std::set<std::string>> list;
+            uint64_t version;
+            bool indexed;
+        };
+        // parallel to 'sources'
+        std::vector<Entry> entries;
+        std::unordered_set<std::string> names;
+        // scratch
+        std::vector<Source::List> lists;
+        std::string key;
+
+        // returns true if any Source, or list, has changed.
+        // 'names' is only (re)built if 'build'
+        bool refresh(const sources_t& sources, bool build);
+    } claimIndex;
+
+    // recently searched names which no Source claimed.  cf. Config::search_miss_cache
+    // only accessed from onSearch(), except for statistics
+    struct MissCache {
+        // oldest first.  Points to keys of 'names'
+        typedef std::list<std::pair<epicsTime, const std::string*>> order_t;
+        order_t order;
+        std::unordered_map<std::string, order_t::iterator> names;
+
+        std::atomic<uint64_t> nhit{0u};
+        std::atomic<uint64_t> nmiss{0u};
+        std::atomic<size_t> nsize{0u};
+
+        // true if name is a cached miss
+        bool lookup(const std::string& name, const epicsTime& now);
+        void insert(const std::string& name, const epicsTime& expires, size_t limit);
+        void clear();
+    } missCache;
+
+    // names which Sources must be asked about, and their index in searchOp
+    Source::Search searchAsk;
+    std::vector<size_t> searchAskIdx;
 
     enum state_t {
         Stopped,
@@ -248,6 +349,9 @@ struct Server::Pvt
     void start();
     void stop();
 
+    // least loaded worker
+    ServerWorker* pickWorker();
+
 private:
     void onSearch(const UDPManager::Search& msg);
     void doBeacons(short evt);
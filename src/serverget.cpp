@@ -115,7 +115,7 @@ struct ServerGPR : public ServerOp
                 conn->opByIOID.erase(it);
 
                 if(self->onClose)
-                    conn->iface->server->acceptor_loop.dispatch([self](){
+                    conn->worker->loop.dispatch([self](){
                         self->onClose("");
                     });
 
@@ -163,6 +163,7 @@ struct ServerGPRConnect : public server::ConnectOp
                      const Value& request,
                      const std::weak_ptr<ServerGPR>& op)
         :server(server)
+        ,worker(conn->worker)
         ,op(op)
     {
         switch(cmd) {
@@ -185,7 +186,7 @@ struct ServerGPRConnect : public server::ConnectOp
         auto serv = server.lock();
         if(!serv)
             return;
-        serv->acceptor_loop.call([this, &prototype](){
+        worker->loop.call([this, &prototype](){
             if(auto oper = op.lock()) {
                 if(oper->state!=ServerOp::Creating)
                     return;
@@ -212,7 +213,7 @@ struct ServerGPRConnect : public server::ConnectOp
         auto serv = server.lock();
         if(!serv)
             return;
-        serv->acceptor_loop.call([this, &msg](){
+        worker->loop.call([this, &msg](){
             if(auto oper = op.lock()) {
                 if(oper->state==ServerOp::Creating)
                     oper->doReply(Value(), msg);
@@ -225,7 +226,7 @@ struct ServerGPRConnect : public server::ConnectOp
         auto serv = server.lock();
         if(!serv)
             return;
-        serv->acceptor_loop.call([this, &fn](){
+        worker->loop.call([this, &fn](){
             if(auto oper = op.lock())
                 oper->onGet = std::move(fn);
         });
@@ -235,7 +236,7 @@ struct ServerGPRConnect : public server::ConnectOp
         auto serv = server.lock();
         if(!serv)
             return;
-        serv->acceptor_loop.call([this, &fn](){
+        worker->loop.call([this, &fn](){
             if(auto oper = op.lock())
                 oper->onPut = std::move(fn);
         });
@@ -245,7 +246,7 @@ struct ServerGPRConnect : public server::ConnectOp
         auto serv = server.lock();
         if(!serv)
             return;
-        serv->acceptor_loop.call([this, &fn](){
+        worker->loop.call([this, &fn](){
             if(auto oper = op.lock())
                 oper->onClose = std::move(fn);
         });
@@ -256,7 +257,7 @@ struct ServerGPRConnect : public server::ConnectOp
         std::pair<std::string, Value> ret;
         auto serv = server.lock();
         if(serv)
-            serv->acceptor_loop.call([this, &ret](){
+            worker->loop.call([this, &ret](){
                 if(auto oper = op.lock())
                     if(auto chan = oper->chan.lock())
                         if(auto conn = chan->conn.lock())
@@ -266,6 +267,8 @@ struct ServerGPRConnect : public server::ConnectOp
     }
 
     const std::weak_ptr<server::Server::Pvt> server;
+    // valid while server is alive
+    ServerWorker* const worker;
     const std::weak_ptr<ServerGPR> op;
 
     INST_COUNTER(ServerGPRConnect);
@@ -280,6 +283,7 @@ struct ServerGPRExec : public server::ExecOp
                   const Value& request,
                   const std::weak_ptr<ServerGPR>& op)
         :server(server)
+        ,worker(conn->worker)
         ,op(op)
     {
         switch(cmd) {
@@ -304,7 +308,7 @@ struct ServerGPRExec : public server::ExecOp
         auto serv = server.lock();
         if(!serv)
             return;
-        serv->acceptor_loop.call([this, &val](){
+        worker->loop.call([this, &val](){
             if(auto oper = op.lock()) {
                 oper->doReply(val, std::string());
             }
@@ -318,7 +322,7 @@ struct ServerGPRExec : public server::ExecOp
         auto serv = server.lock();
         if(!serv)
             return;
-        serv->acceptor_loop.call([this, &msg](){
+        worker->loop.call([this, &msg](){
             if(auto oper = op.lock()) {
                 oper->doReply(Value(), msg);
             }
@@ -330,7 +334,7 @@ struct ServerGPRExec : public server::ExecOp
         auto serv = server.lock();
         if(!serv)
             return;
-        serv->acceptor_loop.call([this, &fn](){
+        worker->loop.call([this, &fn](){
             if(auto oper = op.lock())
                 oper->onCancel = std::move(fn);
         });
@@ -341,7 +345,7 @@ struct ServerGPRExec : public server::ExecOp
         std::pair<std::string, Value> ret;
         auto serv = server.lock();
         if(serv)
-            serv->acceptor_loop.call([this, &ret](){
+            worker->loop.call([this, &ret](){
                 if(auto oper = op.lock())
                     if(auto chan = oper->chan.lock())
                         if(auto conn = chan->conn.lock())
@@ -351,6 +355,8 @@ struct ServerGPRExec : public server::ExecOp
     }
 
     const std::weak_ptr<server::Server::Pvt> server;
+    // valid while server is alive
+    ServerWorker* const worker;
     const std::weak_ptr<ServerGPR> op;
 
     INST_COUNTER(ServerGPRExec);
@@ -63,6 +63,7 @@ struct ServerIntrospectControl : public server::ConnectOp
                             const std::weak_ptr<server::Server::Pvt>& server,
                             const std::weak_ptr<ServerIntrospect>& op)
         :server(server)
+        ,worker(conn->worker)
         ,op(op)
     {
         _op = Info;
@@ -95,7 +96,7 @@ struct ServerIntrospectControl : public server::ConnectOp
         if(!serv)
             return; // soft fail if already completed, cancelled, disconnected, ....
 
-        serv->acceptor_loop.call([this, type, &sts](){
+        worker->loop.call([this, type, &sts](){
             if(auto oper = op.lock())
                 oper->doReply(type, sts);
         });
@@ -106,7 +107,7 @@ struct ServerIntrospectControl : public server::ConnectOp
         auto serv = server.lock();
         if(!serv)
             return;
-        serv->acceptor_loop.call([this, &fn](){
+        worker->loop.call([this, &fn](){
             if(auto oper = op.lock())
                 oper->onClose = std::move(fn);
         });
@@ -117,7 +118,7 @@ struct ServerIntrospectControl : public server::ConnectOp
         std::pair<std::string, Value> ret;
         auto serv = server.lock();
         if(serv)
-            serv->acceptor_loop.call([this, &ret](){
+            worker->loop.call([this, &ret](){
                 if(auto oper = op.lock())
                     if(auto chan = oper->chan.lock())
                         if(auto conn = chan->conn.lock())
@@ -131,6 +132,8 @@ struct ServerIntrospectControl : public server::ConnectOp
     virtual void onPut(std::function<void(std::unique_ptr<server::ExecOp>&& fn, Value&&)>&& fn) override final {}
 
     const std::weak_ptr<server::Server::Pvt> server;
+    // valid while server is alive
+    ServerWorker* const worker;
     const std::weak_ptr<ServerIntrospect> op;
 
     INST_COUNTER(ServerIntrospectControl);
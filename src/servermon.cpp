@@ -32,7 +32,7 @@ struct MonitorOp : public ServerOp,
     {}
     virtual ~MonitorOp() {}
 
-    // only access from acceptor worker thread
+    // only access from connection worker thread
     std::function<void(bool)> onStart;
     std::function<void()> onLowMark;
     std::function<void()> onHighMark;
@@ -40,9 +40,10 @@ struct MonitorOp : public ServerOp,
     // const after setup phase
     std::shared_ptr<const FieldDesc> type;
     BitMask pvMask;
+    EncodePlan plan; // for type and pvMask
     std::string msg;
 
-    // Further members can only be changed from the accepter worker thread with this lock held.
+    // Further members can only be changed from the connection worker thread with this lock held.
     // They may be read from the worker, or if this lock is held.
     mutable epicsMutex lock;
 
@@ -53,20 +54,32 @@ struct MonitorOp : public ServerOp,
     size_t window=0u, limit=1u;
     size_t low=0u, high=0u;
 
-    std::deque<Value> queue;
+    struct Entry {
+        Value val;
+        // fields of val overwritten by squashed updates.  empty if none.
+        BitMask overrun;
+        // val is a private copy, never shared with other subscriptions nor
+        // encoded through the UpdateCache.  So may be modified in place.
+        bool owned=false;
+        Entry() = default;
+        Entry(const Value& val) :val(val) {}
+    };
+    std::deque<Entry> queue;
+    // number of updates squashed into an already queued Entry
+    size_t nSquash=0u;
 
     INST_COUNTER(MonitorOp);
 
     // caller must hold lock.
     // only used after State==Idle
     static
-    void maybeReply(server::Server::Pvt* server, const std::shared_ptr<MonitorOp>& op)
+    void maybeReply(ServerWorker* worker, const std::shared_ptr<MonitorOp>& op)
     {
         // can we send a reply?
         if(!op->scheduled && op->state==Executing && !op->queue.empty() && (!op->pipeline || op->window))
         {
             // based on operation state, yes
-            server->acceptor_loop.dispatch([op](){
+            worker->loop.dispatch([op](){
                 auto ch(op->chan.lock());
                 if(!ch)
                     return;
@@ -110,7 +123,7 @@ struct MonitorOp : public ServerOp,
             if(queue.empty() || (pipeline && !window)) {
                 return; // nothing to do
 
-            } else if(!queue.front()) {
+            } else if(!queue.front().val) {
                 finished = true;
                 subcmd = 0x10;
                 state = Dead;
@@ -120,30 +133,35 @@ struct MonitorOp : public ServerOp,
         {
             (void)evbuffer_drain(conn->txBody.get(), evbuffer_get_length(conn->txBody.get()));
 
-            EvOutBuf R(hostBE, conn->txBody.get());
-            to_wire(R, uint32_t(ioid));
-            to_wire(R, subcmd);
-            if(subcmd&0x08) {
-                if(!msg.empty() || !type) {
-                    to_wire(R, Status::error(msg));
-
-                } else {
-                    to_wire(R, Status{});
-                    to_wire(R, type.get());
+            Entry ent;
+            {
+                EvOutBuf R(hostBE, conn->txBody.get());
+                to_wire(R, uint32_t(ioid));
+                to_wire(R, subcmd);
+                if(subcmd&0x08) {
+                    if(!msg.empty() || !type) {
+                        to_wire(R, Status::error(msg));
+
+                    } else {
+                        to_wire(R, Status{});
+                        to_wire(R, type.get());
+                    }
+
+                } else if(!queue.empty()) {
+                    ent = std::move(queue.front());
+                    queue.pop_front();
+
+                    if(!ent.val) { // finish (could be used to send an error)
+                        to_wire(R, Status{});
+                    }
                 }
+            }
 
-            } else if(!queue.empty()) {
-                auto& ent = queue.front();
-                if(ent) {
-                    to_wire_valid(R, ent, &pvMask);
-                    // TODO: placeholder for overrun mask
-                    to_wire(R, uint8_t(0u));
-
-                } else { // finish (could be used to send an error)
-                    to_wire(R, Status{});
-                }
+            if(ent.val) {
+                conn->worker->updateCache.encode(conn->txBody.get(), ent.val, plan, hostBE);
 
-                queue.pop_front();
+                EvOutBuf R(hostBE, conn->txBody.get());
+                to_wire(R, ent.overrun);
             }
         }
 
@@ -157,7 +175,7 @@ struct MonitorOp : public ServerOp,
                 conn->opByIOID.erase(it);
 
                 if(self->onClose)
-                    conn->iface->server->acceptor_loop.dispatch([self](){
+                    conn->worker->loop.dispatch([self](){
                         self->onClose("");
                     });
 
@@ -178,7 +196,7 @@ struct MonitorOp : public ServerOp,
             bool after = window <= low;
 
             if(before && after && onLowMark) {
-                conn->iface->server->acceptor_loop.dispatch([self]() {
+                conn->worker->loop.dispatch([self]() {
                     if(self->onLowMark)
                         self->onLowMark();
                 });
@@ -189,7 +207,7 @@ struct MonitorOp : public ServerOp,
             // reshedule myself
             assert(!scheduled); // we've been holding the lock, so this should not have changed
 
-            conn->iface->server->acceptor_loop.dispatch([self]() {
+            conn->worker->loop.dispatch([self]() {
                 self->doReply();
             });
             scheduled = true;
@@ -227,21 +245,36 @@ struct ServerMonitorControl : public server::MonitorControlOp
             Guard G(mon->lock);
 
             if((mon->queue.size() < mon->limit) || force || !val) {
-                mon->queue.push_back(val);
+                mon->queue.emplace_back(val);
 
             } else if(!maybe) {
                 // squash
                 assert(mon->limit>0 && !mon->queue.empty());
 
-                mon->queue.back().assign(val);
-                // TODO track overrun
+                auto& back = mon->queue.back();
+                // fields about to be overwritten, which the client will never see
+                overrunmask(back.overrun, back.val, val, &mon->pvMask);
+                // a posted Value may also be queued for other subscriptions, and its
+                // serialization cached.  The UpdateCache holds only a weak_ptr,
+                // so use_count() can't tell.  Always modify a private copy.
+                if(back.val && !back.owned) {
+                    back.val = back.val.clone();
+                    back.owned = true;
+                }
+                if(Value::Helper::desc(back.val)==Value::Helper::desc(val)) {
+                    // only fields which will be sent
+                    Value::Helper::assignSame(back.val, val, &mon->pvMask);
+                } else {
+                    back.val.assign(val);
+                }
+                mon->nSquash++;
 
             } else {
                 // nope
             }
 
             if(auto serv = server.lock())
-                MonitorOp::maybeReply(serv.get(), mon);
+                MonitorOp::maybeReply(worker, mon);
         }
 
         return mon->queue.size() < mon->limit;
@@ -262,6 +295,7 @@ struct ServerMonitorControl : public server::MonitorControlOp
         stat.nQueue = mon->queue.size();
         stat.limitQueue = mon->limit;
         stat.window = mon->window;
+        stat.nSquash = mon->nSquash;
     }
 
     virtual void setWatermarks(size_t low, size_t high) override final
@@ -272,7 +306,7 @@ struct ServerMonitorControl : public server::MonitorControlOp
         auto serv = server.lock();
         if(!serv)
             return;
-        serv->acceptor_loop.call([this, low, high](){
+        worker->loop.call([this, low, high](){
             if(auto oper = op.lock()) {
                 Guard G(oper->lock);
                 oper->low = low;
@@ -286,7 +320,7 @@ struct ServerMonitorControl : public server::MonitorControlOp
         auto serv = server.lock();
         if(!serv)
             return;
-        serv->acceptor_loop.call([this, &fn](){
+        worker->loop.call([this, &fn](){
             if(auto oper = op.lock())
                 oper->onStart = std::move(fn);
         });
@@ -296,7 +330,7 @@ struct ServerMonitorControl : public server::MonitorControlOp
         auto serv = server.lock();
         if(!serv)
             return;
-        serv->acceptor_loop.call([this, &fn](){
+        worker->loop.call([this, &fn](){
             if(auto oper = op.lock())
                 oper->onHighMark = std::move(fn);
         });
@@ -306,7 +340,7 @@ struct ServerMonitorControl : public server::MonitorControlOp
         auto serv = server.lock();
         if(!serv)
             return;
-        serv->acceptor_loop.call([this, &fn](){
+        worker->loop.call([this, &fn](){
             if(auto oper = op.lock())
                 oper->onLowMark = std::move(fn);
         });
@@ -317,7 +351,7 @@ struct ServerMonitorControl : public server::MonitorControlOp
         std::pair<std::string, Value> ret;
         auto serv = server.lock();
         if(serv)
-            serv->acceptor_loop.call([this, &ret](){
+            worker->loop.call([this, &ret](){
                 if(auto oper = op.lock())
                     if(auto chan = oper->chan.lock())
                         if(auto conn = chan->conn.lock())
@@ -327,6 +361,8 @@ struct ServerMonitorControl : public server::MonitorControlOp
     }
 
     const std::weak_ptr<server::Server::Pvt> server;
+    // valid while server is alive
+    ServerWorker* const worker;
     const std::weak_ptr<MonitorOp> op;
 
     INST_COUNTER(ServerMonitorControl);
@@ -340,6 +376,7 @@ struct ServerMonitorSetup : public server::MonitorSetupOp
                      const Value& request,
                      const std::weak_ptr<MonitorOp>& op)
         :server(server)
+        ,worker(conn->worker)
         ,op(op)
     {
         _op = Info;
@@ -364,11 +401,12 @@ struct ServerMonitorSetup : public server::MonitorSetupOp
         auto serv = server.lock();
         if(!serv)
             return ret;
-        serv->acceptor_loop.call([this, &type, &ret, &mask](){
+        worker->loop.call([this, &type, &ret, &mask](){
             if(auto oper = op.lock()) {
                 if(oper->state!=ServerOp::Creating)
                     return;
                 oper->type = type;
+                oper->plan.reset(type.get(), &mask);
                 oper->pvMask = std::move(mask);
                 ret.reset(new ServerMonitorControl(this, server, _name, oper));
                 oper->doReply();
@@ -386,7 +424,7 @@ struct ServerMonitorSetup : public server::MonitorSetupOp
         auto serv = server.lock();
         if(!serv)
             return;
-        serv->acceptor_loop.call([this, &msg](){
+        worker->loop.call([this, &msg](){
             if(auto oper = op.lock()) {
                 if(oper->state==ServerOp::Creating) {
                     oper->msg = msg;
@@ -400,7 +438,7 @@ struct ServerMonitorSetup : public server::MonitorSetupOp
         auto serv = server.lock();
         if(!serv)
             return;
-        serv->acceptor_loop.call([this, &fn](){
+        worker->loop.call([this, &fn](){
             if(auto oper = op.lock())
                 oper->onClose = std::move(fn);
         });
@@ -411,7 +449,7 @@ struct ServerMonitorSetup : public server::MonitorSetupOp
         std::pair<std::string, Value> ret;
         auto serv = server.lock();
         if(serv)
-            serv->acceptor_loop.call([this, &ret](){
+            worker->loop.call([this, &ret](){
                 if(auto oper = op.lock())
                     if(auto chan = oper->chan.lock())
                         if(auto conn = chan->conn.lock())
@@ -421,6 +459,8 @@ struct ServerMonitorSetup : public server::MonitorSetupOp
     }
 
     const std::weak_ptr<server::Server::Pvt> server;
+    // valid while server is alive
+    ServerWorker* const worker;
     const std::weak_ptr<MonitorOp> op;
 
     INST_COUNTER(ServerMonitorSetup);
@@ -432,6 +472,7 @@ ServerMonitorControl::ServerMonitorControl(ServerMonitorSetup* setup,
                                            const std::string& name,
                                            const std::weak_ptr<MonitorOp>& op)
     :server(server)
+    ,worker(setup->worker)
     ,op(op)
 {
     _op = Info;
@@ -442,6 +483,60 @@ ServerMonitorControl::ServerMonitorControl(ServerMonitorSetup* setup,
 
 } // namespace
 
+void UpdateCache::encode(evbuffer* buf, const Value& val, const EncodePlan& plan, bool be)
+{
+    auto& mask = plan.mask;
+    auto store(Value::Helper::store(val));
+
+    Entry* ent = nullptr;
+    for(auto& cand : entries) {
+        if(cand.ptr==store.get() && cand.be==be && !cand.val.expired() && cand.mask==mask) {
+            ent = &cand;
+            break;
+        }
+    }
+
+    if(!ent) {
+        evbuf body(evbuffer_new());
+        {
+            EvOutBuf M(be, body.get());
+            to_wire_valid(M, val, plan);
+            if(!M.good())
+                throw std::bad_alloc();
+        }
+
+        if(entries.size() >= limit)
+            entries.pop_front();
+
+        entries.emplace_back();
+        ent = &entries.back();
+        ent->val = store;
+        ent->ptr = store.get();
+        ent->mask.resize(mask.size()); // not copyable
+        for(auto i : range(mask.wsize()))
+            ent->mask.word(i) = mask.word(i);
+        ent->be = be;
+        ent->body = std::move(body);
+    }
+
+#if LIBEVENT_VERSION_NUMBER >= 0x02010000
+    // share chains of the cached body
+    if(!evbuffer_add_buffer_reference(buf, ent->body.get()))
+        return;
+#endif
+
+    // copy, leaving the cached body unchanged
+    auto len = evbuffer_get_length(ent->body.get());
+    evbuffer_iovec vec{};
+    if(evbuffer_reserve_space(buf, len, &vec, 1)!=1 || vec.iov_len<len)
+        throw std::bad_alloc();
+    auto n = evbuffer_copyout(ent->body.get(), vec.iov_base, len);
+    assert(n>=0 && size_t(n)==len);
+    vec.iov_len = len;
+    if(evbuffer_commit_space(buf, &vec, 1))
+        throw std::bad_alloc();
+}
+
 void ServerConn::handle_MONITOR()
 {
     EvInBuf M(peerBE, segBuf.get(), 16);
@@ -565,7 +660,7 @@ void ServerConn::handle_MONITOR()
             bool after = op->window > op->high;
 
             if(!before && after && op->onHighMark) {
-                iface->server->acceptor_loop.dispatch([op](){
+                worker->loop.dispatch([op](){
                     if(op->onHighMark)
                         op->onHighMark();
                 });
@@ -588,7 +683,7 @@ void ServerConn::handle_MONITOR()
 
             {
                 Guard G(op->lock);
-                MonitorOp::maybeReply(iface->server, op);
+                MonitorOp::maybeReply(worker, op);
             }
         }
 
@@ -602,7 +697,7 @@ void ServerConn::handle_MONITOR()
                 opByIOID.erase(it);
 
                 if(self->onClose) {
-                    iface->server->acceptor_loop.dispatch([self](){
+                    worker->loop.dispatch([self](){
                         if(self->onClose)
                             self->onClose("");
                     });
@@ -19,6 +19,17 @@ ServerSource::ServerSource(server::Server::Pvt* serv)
     ,info(TypeDef(TypeCode::Struct, {
                       Member(TypeCode::String, "implLang"),
                       Member(TypeCode::String, "version"),
+                      Member(TypeCode::Struct, "searchMissCache", {
+                          Member(TypeCode::UInt64, "hit"),
+                          Member(TypeCode::UInt64, "miss"),
+                          Member(TypeCode::UInt64, "size"),
+                      }),
+                      Member(TypeCode::Struct, "searchUDP", {
+                          Member(TypeCode::UInt64, "rxPackets"),
+                          Member(TypeCode::UInt64, "rxSyscalls"),
+                          Member(TypeCode::UInt64, "txPackets"),
+                          Member(TypeCode::UInt64, "txSyscalls"),
+                      }),
                   }).create())
 {}
 
@@ -85,6 +96,23 @@ void ServerSource::onCreate(std::unique_ptr<server::ChannelControl> &&op)
 
             ret["implLang"] = "cpp";
             ret["version"] = version_str();
+            ret["searchMissCache.hit"] = serv->missCache.nhit.load(std::memory_order_relaxed);
+            ret["searchMissCache.miss"] = serv->missCache.nmiss.load(std::memory_order_relaxed);
+            ret["searchMissCache.size"] = uint64_t(serv->missCache.nsize.load(std::memory_order_relaxed));
+
+            // includes traffic of any other Server in this process on the same UDP port
+            UDPListener::Stats udp{};
+            for(auto& L : serv->listeners) {
+                auto S(L->stats());
+                udp.rxPackets += S.rxPackets;
+                udp.rxSyscalls += S.rxSyscalls;
+                udp.txPackets += S.txPackets;
+                udp.txSyscalls += S.txSyscalls;
+            }
+            ret["searchUDP.rxPackets"] = udp.rxPackets;
+            ret["searchUDP.rxSyscalls"] = udp.rxSyscalls;
+            ret["searchUDP.txPackets"] = udp.txPackets;
+            ret["searchUDP.txSyscalls"] = udp.txSyscalls;
 
             eop->reply(ret);
             return;
@@ -5,6 +5,7 @@
  */
 
 #include <string.h>
+#include <stdlib.h>
 
 #include <epicsTypes.h>
 
@@ -65,7 +66,7 @@ size_t elementSize(ArrayType type)
 shared_array<void> allocArray(ArrayType type, size_t count)
 {
     switch(type) {
-#define CASE(CODE, TYPE) case ArrayType::CODE: return shared_array<TYPE>(count).castTo<void>()
+#define CASE(CODE, TYPE) case ArrayType::CODE: return allocUninitialized<TYPE>(count).castTo<void>()
     CASE(Bool, bool);
     CASE(UInt8, uint8_t);
     CASE(UInt16, uint16_t);
@@ -77,6 +78,8 @@ shared_array<void> allocArray(ArrayType type, size_t count)
     CASE(Int64, int64_t);
     CASE(Float32, float);
     CASE(Float64, double);
+#undef CASE
+#define CASE(CODE, TYPE) case ArrayType::CODE: return shared_array<TYPE>(count).castTo<void>()
     CASE(String, std::string);
     CASE(Value, Value);
 #undef CASE
@@ -89,6 +92,29 @@ shared_array<void> allocArray(ArrayType type, size_t count)
 
 namespace detail {
 
+void* alignedAlloc(size_t nbytes)
+{
+    static_assert(sa_alignment>=2u*sizeof(void*) && (sa_alignment&(sa_alignment-1u))==0u,
+                  "sa_alignment must be a power of 2, with room for the original pointer");
+
+    // over allocate, and keep the original pointer just before the aligned block
+    if(nbytes > size_t(-1)-sa_alignment)
+        throw std::bad_alloc();
+    auto raw = static_cast<char*>(malloc(nbytes + sa_alignment));
+    if(!raw)
+        throw std::bad_alloc();
+
+    auto ret = reinterpret_cast<char*>((reinterpret_cast<uintptr_t>(raw) + sa_alignment) & ~uintptr_t(sa_alignment-1u));
+    reinterpret_cast<void**>(ret)[-1] = raw;
+    return ret;
+}
+
+void alignedFree(void* ptr)
+{
+    if(ptr)
+        free(reinterpret_cast<void**>(ptr)[-1]);
+}
+
 namespace {
 
 template<typename E>
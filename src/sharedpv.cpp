@@ -47,9 +47,19 @@ struct SharedPV::Impl : public std::enable_shared_from_this<Impl>
     std::set<std::shared_ptr<MonitorControlOp>> subscribers;
 
     Value current;
+    // true when 'current' may also be referenced by a queued update or reply.
+    // post() must then copy before modifying.
+    bool currentShared = false;
 
     INST_COUNTER(SharedPVImpl);
 
+    // call with lock held
+    Value shareCurrent()
+    {
+        currentShared = true;
+        return current;
+    }
+
     static
     void connectOp(const std::shared_ptr<Impl>& self, const std::shared_ptr<ConnectOp>& conn)
     {
@@ -77,7 +87,7 @@ struct SharedPV::Impl : public std::enable_shared_from_this<Impl>
                 self->subscribers.erase(sub);
             });
 
-            sub->post(self->current.clone());
+            sub->post(self->shareCurrent());
             self->subscribers.emplace(std::move(sub));
 
         }catch(std::exception& e){
@@ -183,7 +193,7 @@ void SharedPV::attach(std::unique_ptr<ChannelControl>&& ctrlop)
             {
                 Guard G(self->lock);
                 if(self->current)
-                    got = self->current.clone();
+                    got = self->shareCurrent();
             }
             if(got) {
                 op->reply(got);
@@ -352,6 +362,7 @@ void SharedPV::open(const Value& initial)
         mpending = std::move(impl->mpending);
 
         impl->current = initial.clone();
+        impl->currentShared = false;
     }
 
     // TODO the following is really inefficient if we aren't on a worker.
@@ -360,8 +371,12 @@ void SharedPV::open(const Value& initial)
     for(auto& op : pending) {
         Impl::connectOp(impl, op);
     }
-    for(auto& op : mpending) {
-        Impl::connectSub(impl, op);
+    {
+        // as from onSubscribe(), connectSub() expects the lock
+        Guard G(impl->lock);
+        for(auto& op : mpending) {
+            Impl::connectSub(impl, op);
+        }
     }
 
     {
@@ -369,7 +384,7 @@ void SharedPV::open(const Value& initial)
 
         //c++17 adds std::set::merge()
         for(auto& sub : subscribers) {
-            sub->post(impl->current.clone());
+            sub->post(impl->shareCurrent());
             impl->subscribers.insert(sub);
         }
     }
@@ -420,11 +435,18 @@ void SharedPV::post(const Value& val)
     else if(Value::Helper::desc(impl->current)!=Value::Helper::desc(val))
         throw std::logic_error("post() requires the exact type of open().  Recommend pvxs::Value::cloneEmpty()");
 
+    if(impl->currentShared) {
+        // copy on write.  Only the first post() after a GET or new subscriber
+        // pays, with a full copy of the structure.
+        impl->current = impl->current.clone();
+        impl->currentShared = false;
+    }
     impl->current.assign(val);
 
     if(impl->subscribers.empty())
         return;
 
+    // caller may re-use val.  A full copy, whatever the number of marked fields.
     auto copy(val.clone());
 
     for(auto& sub : impl->subscribers) {
@@ -466,6 +488,8 @@ struct StaticSource::Impl : public Source
 
     list_t pvs;
     decltype (List::names) list;
+    // incremented by add() and remove().  cf. List::version
+    uint64_t version = 1u;
 
     virtual void onSearch(Search &op) override
     {
@@ -493,10 +517,17 @@ struct StaticSource::Impl : public Source
 
     virtual List onList() override
     {
-        List ret;
-        auto G(lock.lockReader());
+        {
+            auto G(lock.lockReader());
 
-        if(!list || list.use_count()!=1u) {
+            if(list)
+                return List{list, false, version};
+        }
+
+        // called concurrently for searches and "pvlist".  So only replace 'list' while exclusive.
+        auto G(lock.lockWriter());
+
+        if(!list) {
             auto temp = std::make_shared<std::set<std::string>>();
             for(auto& pair : pvs) {
                 temp->emplace(pair.first);
@@ -504,10 +535,7 @@ struct StaticSource::Impl : public Source
             list = std::move(temp);
         }
 
-        ret.names = list;
-        ret.dynamic = false;
-
-        return ret;
+        return List{list, false, version};
     }
 
     virtual void show(std::ostream& strm) override final
@@ -564,6 +592,7 @@ StaticSource& StaticSource::add(const std::string& name, const SharedPV &pv)
 
     impl->pvs[name] = pv;
     impl->list.reset();
+    impl->version++;
 
     return *this;
 }
@@ -583,6 +612,7 @@ StaticSource& StaticSource::remove(const std::string& name)
         pv = it->second;
         impl->pvs.erase(it);
         impl->list.reset();
+        impl->version++;
     }
 
     pv.close();
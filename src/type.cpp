@@ -4,6 +4,7 @@
  * in file LICENSE that is included with this distribution.
  */
 
+#include <algorithm>
 #include <cstring>
 #include <epicsAssert.h>
 
@@ -434,6 +435,34 @@ std::ostream& operator<<(std::ostream& strm, const TypeDef& def)
 
 namespace impl {
 
+namespace {
+struct FieldMapLess {
+    const char* name;
+    size_t len;
+    bool operator()(const FieldMap::value_type& ent, const FieldMapLess& key) const {
+        return ent.first.compare(0u, std::string::npos, key.name, key.len) < 0;
+    }
+};
+} // namespace
+
+FieldMap::const_iterator FieldMap::find(const char* name, size_t len) const
+{
+    FieldMapLess key{name, len};
+    auto it = std::lower_bound(entries.begin(), entries.end(), key, key);
+    if(it!=entries.end() && it->first.compare(0u, std::string::npos, name, len)==0)
+        return it;
+    return entries.end();
+}
+
+size_t& FieldMap::operator[](const std::string& name)
+{
+    FieldMapLess key{name.data(), name.size()};
+    auto it = std::lower_bound(entries.begin(), entries.end(), key, key);
+    if(it==entries.end() || it->first!=name)
+        it = entries.emplace(it, name, 0u);
+    return it->second;
+}
+
 void show_FieldDesc(std::ostream& strm, const FieldDesc* desc)
 {
     for(auto idx : range(desc->size())) {
@@ -444,7 +473,6 @@ void show_FieldDesc(std::ostream& strm, const FieldDesc* desc)
 
         switch(fld.code.code) {
         case TypeCode::Struct:
-            // note: need to ensure stable lexical iteration order if fld.mlookup ever becomes unordered_map
             for(auto& pair : fld.mlookup) {
                 strm<<indent{}<<"    "<<pair.first<<" -> "<<pair.second<<" ["<<(idx+pair.second)<<"]\n";
             }
@@ -11,6 +11,7 @@
 #include <vector>
 #include <tuple>
 #include <memory>
+#include <atomic>
 
 #include <epicsThread.h>
 #include <epicsMutex.h>
@@ -41,7 +42,11 @@ struct UDPCollector : public UDPManager::Search,
     evevent rx;
     uint32_t prevndrop;
 
-    std::vector<uint8_t> buf;
+    UDPRxBatch batch;
+    // replies queued while processing a batch
+    mutable UDPTxBatch replies;
+    // copies of batch and replies statistics, readable from any thread
+    std::atomic<uint64_t> nrxpacket{0u}, nrxsyscall{0u}, ntxpacket{0u}, ntxsyscall{0u};
 
     UDPManager::Beacon beaconMsg;
 
@@ -50,19 +55,12 @@ struct UDPCollector : public UDPManager::Search,
     UDPCollector(const std::shared_ptr<UDPManager::Pvt>& manager, const SockAddr& bind_addr);
     ~UDPCollector();
 
-    bool handle_one()
+    // receive a batch.  Returns false to wait for more I/O
+    bool handle_batch()
     {
-        osiSocklen_t alen = src.size();
-        uint32_t ndrop = 0u;
-
-        // For Search messages, we use PV name strings in-place by adding nils.
-        // Ensure one extra byte at the end of the buffer for a nil after the last PV name
-        const int nrx = recvfromx(sock.sock, (char*)&buf[0], buf.size()-1, &src->sa, &alen, &ndrop);
-
-        if(nrx>=0 && ndrop!=0u && prevndrop!=ndrop) {
-            log_debug_printf(logio, "UDP collector socket buffer overflowed %u -> %u\n", unsigned(prevndrop), unsigned(ndrop));
-            prevndrop = ndrop;
-        }
+        const int nrx = batch.receive(sock.sock);
+        nrxpacket.store(batch.npacket, std::memory_order_relaxed);
+        nrxsyscall.store(batch.nsyscall, std::memory_order_relaxed);
 
         if(nrx<0) {
             int err = evutil_socket_geterror(sock.sock);
@@ -73,13 +71,62 @@ struct UDPCollector : public UDPManager::Search,
                            evutil_socket_error_to_string(err));
             }
             return false; // wait for more I/O
+        }
+
+        for(auto i : range(size_t(nrx))) {
+            auto& dg = batch[i];
+
+            if(dg.ndrop!=0u && prevndrop!=dg.ndrop) {
+                log_debug_printf(logio, "UDP collector socket buffer overflowed %u -> %u\n", unsigned(prevndrop), unsigned(dg.ndrop));
+                prevndrop = dg.ndrop;
+            }
+
+            src = dg.src;
+            handle_one(dg.buf, dg.len);
+        }
+
+        flush_replies();
+
+        // a partial batch means the socket buffer is empty
+        return size_t(nrx)==batch.capacity();
+    }
+
+    void flush_replies()
+    {
+        if(!replies.size())
+            return;
+
+        const auto nsyscall0 = replies.nsyscall;
+
+        (void)replies.flush(sock.sock);
+        ntxpacket.store(replies.npacket, std::memory_order_relaxed);
+        ntxsyscall.store(replies.nsyscall, std::memory_order_relaxed);
+
+        log_debug_printf(logio, "%s sent %zu replies with %zu syscalls\n", name.c_str(),
+                         replies.size(), replies.nsyscall - nsyscall0);
 
-        } else if(nrx<8) {
+        for(auto i : range(replies.size())) {
+            auto& dg = replies[i];
+            if(dg.ntx>=0 || dg.err==SOCK_EWOULDBLOCK || dg.err==EAGAIN || dg.err==SOCK_EINTR) {
+                // nothing to do here
+            } else {
+                log_warn_printf(logio, "UDP TX Error on %s : %s\n", name.c_str(),
+                           evutil_socket_error_to_string(dg.err));
+            }
+        }
+        replies.clear();
+    }
+
+    // For Search messages, we use PV name strings in-place by adding nils.
+    // buf has one extra byte at the end for a nil after the last PV name
+    void handle_one(uint8_t *buf, size_t nrx)
+    {
+        if(nrx<8) {
             // maybe a zero (body) length packet?
             // maybe an OS error?
 
             log_info_printf(logio, "UDP ignore runt on %s\n", name.c_str());
-            return true;
+            return;
 
         } else if(buf[0]!=0xca || buf[1]==0 || (buf[2]&(pva_flags::Control|pva_flags::SegMask))) {
             // minimum header size is 8 bytes
@@ -90,16 +137,16 @@ struct UDPCollector : public UDPManager::Search,
             log_info_printf(logio, "UDP ignore header%u %02x%02x%02x%02x on %s\n",
                        unsigned(nrx), buf[0], buf[1], buf[2], buf[3],
                     name.c_str());
-            return true;
+            return;
         }
 
-        log_hex_printf(logio, Level::Debug, &buf[0], nrx, "UDP Rx %d from %s\n", nrx, src.tostring().c_str());
+        log_hex_printf(logio, Level::Debug, &buf[0], nrx, "UDP Rx %u from %s\n", unsigned(nrx), src.tostring().c_str());
 
         names.clear();
 
         bool be = buf[2]&pva_flags::MSB;
 
-        FixedBuf M(be, buf.data(), nrx);
+        FixedBuf M(be, buf, nrx);
 
         uint8_t cmd = M[3];
 
@@ -111,7 +158,7 @@ struct UDPCollector : public UDPManager::Search,
             log_info_printf(logio, "UDP ignore header%u %02x%02x%02x%02x on %s\n",
                        unsigned(M.size()), M[0], M[1], M[2], M[3],
                     name.c_str());
-            return true;
+            return;
         }
 
         switch(cmd) {
@@ -212,8 +259,6 @@ struct UDPCollector : public UDPManager::Search,
         }
             break;
         }
-
-        return true;
     }
     void handle(short ev)
     {
@@ -221,8 +266,8 @@ struct UDPCollector : public UDPManager::Search,
         if(!(ev&EV_READ))
             return;
 
-        // handle up to 4 packets before going back to the reactor
-        for(unsigned i=0; i<4 && handle_one(); i++) {}
+        // handle up to 4 batches before going back to the reactor
+        for(unsigned i=0; i<4 && handle_batch(); i++) {}
     }
     static void handle_static(evutil_socket_t fd, short ev, void *raw)
     {
@@ -262,7 +307,8 @@ UDPCollector::UDPCollector(const std::shared_ptr<UDPManager::Pvt>& manager, cons
     ,bind_addr(bind_addr)
     ,sock(bind_addr.family(), SOCK_DGRAM, 0)
     ,rx(event_new(manager->loop.base, sock.sock, EV_READ|EV_PERSIST, &handle_static, this))
-    ,buf(0x10001)
+    ,prevndrop(0u)
+    ,batch(16u)
     ,beaconMsg(src)
 {
     manager->loop.assertInLoop();
@@ -419,6 +465,16 @@ UDPListener::~UDPListener()
     // UDPManager may be destroyed at this point, which joins its event loop worker
 }
 
+UDPListener::Stats UDPListener::stats() const
+{
+    Stats ret;
+    ret.rxPackets = collector->nrxpacket.load(std::memory_order_relaxed);
+    ret.rxSyscalls = collector->nrxsyscall.load(std::memory_order_relaxed);
+    ret.txPackets = collector->ntxpacket.load(std::memory_order_relaxed);
+    ret.txSyscalls = collector->ntxsyscall.load(std::memory_order_relaxed);
+    return ret;
+}
+
 void UDPListener::start(bool s)
 {
     collector->manager->loop.call([this, s](){
@@ -437,18 +493,9 @@ bool UDPCollector::reply(const void *msg, size_t msglen) const
 {
     manager->loop.assertInLoop();
 
-    int ntx = sendto(sock.sock, (char*)msg, msglen, 0, &src->sa, src.size());
-    if(ntx<0) {
-        int err = evutil_socket_geterror(sock.sock);
-        if(err==SOCK_EWOULDBLOCK || err==EAGAIN || err==SOCK_EINTR) {
-            // nothing to do here
-        } else {
-            log_warn_printf(logio, "UDP TX Error on %s : %s\n", name.c_str(),
-                       evutil_socket_error_to_string(err));
-        }
-        return false; // wait for more I/O
-    }
-    return size_t(ntx)==msglen;
+    // sent by flush_replies() after the current batch
+    replies.push(msg, msglen, src);
+    return true;
 }
 
 UDPManager::Search::~Search() {}
@@ -59,6 +59,11 @@ struct PVXS_API UDPManager
         decltype (names)::const_iterator begin() const { return names.begin(); }
         decltype (names)::const_iterator end() const   { return names.end(); }
 
+        /** Queue reply to src.  Sent after the current batch of received datagrams is processed.
+         *
+         *  Returns true once queued.  Since nothing is sent yet, the result no longer
+         *  reflects success of the send.  Errors are logged when the batch is sent.
+         */
         virtual bool reply(const void *msg, size_t msglen) const =0;
         virtual ~Search();
     };
@@ -100,6 +105,13 @@ public:
 
     void start(bool s=true);
     inline void stop() { start(false); }
+
+    // counters of the socket bound to dest.  Shared by all listeners of dest.
+    struct Stats {
+        uint64_t rxPackets, rxSyscalls, txPackets, txSyscalls;
+    };
+    // may be called from any thread
+    Stats stats() const;
 };
 
 }} // namespace pvxs::impl
@@ -29,6 +29,9 @@ void testSetup()
 void cleanup_for_valgrind()
 {
     for(auto& pair : instanceSnapshot()) {
+        // running totals, not instances
+        if(pair.first=="StructTopPoolHit" || pair.first=="StructTopPoolMiss")
+            continue;
         // This will mess up test counts, but is the only way
         // 'prove' will print the result in CI runs.
         if(pair.second!=0)
@@ -7,6 +7,7 @@
 // for signal handling
 #include <signal.h>
 
+#include <algorithm>
 #include <iomanip>
 #include <cstring>
 #include <sstream>
@@ -59,6 +60,8 @@ unsigned long version_abi_int()
 #define CASE(KLASS) std::atomic<size_t> cnt_ ## KLASS{}
 
 CASE(StructTop);
+CASE(StructTopPoolHit);
+CASE(StructTopPoolMiss);
 
 CASE(UDPListener);
 CASE(evbase);
@@ -96,6 +99,8 @@ std::map<std::string, size_t> instanceSnapshot()
 #define CASE(KLASS) ret[#KLASS] = cnt_ ## KLASS .load(std::memory_order_relaxed)
 
 CASE(StructTop);
+CASE(StructTopPoolHit);
+CASE(StructTopPoolMiss);
 
 CASE(UDPListener);
 CASE(evbase);
@@ -339,6 +344,219 @@ int recvfromx(SOCKET sock, void *buf, size_t buflen, sockaddr* peer, osiSocklen_
 #endif
 }
 
+#if defined(__linux__) && defined(SO_RXQ_OVFL)
+#  define USE_RECVMMSG
+#endif
+
+struct UDPRxBatch::Pvt {
+#ifdef USE_RECVMMSG
+    std::vector<mmsghdr> hdrs;
+    std::vector<iovec> iovs;
+    struct cbuf_t {
+        alignas (alignof (cmsghdr)) char buf[CMSG_SPACE(4u)];
+    };
+    std::vector<cbuf_t> cbufs;
+#endif
+};
+
+constexpr size_t UDPRxBatch::slotSize;
+
+UDPRxBatch::UDPRxBatch(size_t count)
+    :msgs(count ? count : 1u)
+    ,pvt(new Pvt)
+{
+    // last buffer has room for any datagram
+    slab.resize((msgs.size()-1u)*slotSize + 0x10001);
+
+    for(auto i : range(msgs.size())) {
+        msgs[i].buf = slab.data() + i*slotSize;
+        msgs[i].bufsize = i+1u==msgs.size() ? 0x10001 : slotSize;
+    }
+
+#ifdef USE_RECVMMSG
+    pvt->hdrs.resize(msgs.size());
+    pvt->iovs.resize(msgs.size());
+    pvt->cbufs.resize(msgs.size());
+#endif
+}
+
+UDPRxBatch::~UDPRxBatch() {}
+
+int UDPRxBatch::receive(SOCKET sock)
+{
+#ifdef USE_RECVMMSG
+    for(auto i : range(msgs.size())) {
+        auto& dg = msgs[i];
+        auto& hdr = pvt->hdrs[i].msg_hdr;
+
+        dg.src = SockAddr();
+        pvt->iovs[i] = iovec{dg.buf, dg.bufsize-1u};
+
+        hdr = msghdr{};
+        hdr.msg_iov = &pvt->iovs[i];
+        hdr.msg_iovlen = 1u;
+        hdr.msg_name = &dg.src->sa;
+        hdr.msg_namelen = dg.src.size();
+        hdr.msg_control = pvt->cbufs[i].buf;
+        hdr.msg_controllen = sizeof(pvt->cbufs[i].buf);
+        pvt->hdrs[i].msg_len = 0u;
+    }
+
+    nsyscall++;
+    int ret = recvmmsg(sock, pvt->hdrs.data(), pvt->hdrs.size(), 0, nullptr);
+
+    for(auto i : range(ret>0 ? size_t(ret) : 0u)) {
+        auto& dg = msgs[i];
+        auto& hdr = pvt->hdrs[i].msg_hdr;
+
+        dg.len = pvt->hdrs[i].msg_len;
+
+        if(hdr.msg_flags & MSG_CTRUNC)
+            log_debug_printf(log, "MSG_CTRUNC %zu, %zu\n", size_t(hdr.msg_controllen), sizeof(pvt->cbufs[i].buf));
+        if(hdr.msg_flags & MSG_TRUNC) {
+            ntrunc++;
+            log_info_printf(log, "UDP datagram from %s truncated to %zu bytes\n",
+                            dg.src.tostring().c_str(), dg.len);
+        }
+
+        // counter is only present when changed, so carry forward
+        dg.ndrop = i ? msgs[i-1u].ndrop : msgs.back().ndrop;
+        for(cmsghdr *chdr = CMSG_FIRSTHDR(&hdr); chdr ; chdr = CMSG_NXTHDR(&hdr, chdr)) {
+            if(chdr->cmsg_level==SOL_SOCKET && chdr->cmsg_type==SO_RXQ_OVFL && chdr->cmsg_len>=CMSG_LEN(4u)) {
+                memcpy(&dg.ndrop, CMSG_DATA(chdr), 4u);
+            }
+        }
+    }
+    if(ret>0) {
+        npacket += size_t(ret);
+        // remember the latest counter for the next batch
+        msgs.back().ndrop = msgs[ret-1].ndrop;
+    }
+
+    return ret;
+
+#else
+    // one datagram per syscall.  socket is non-blocking, so stop at the first error.
+    int nrx = 0;
+    for(auto& dg : msgs) {
+        dg.src = SockAddr();
+        osiSocklen_t alen = dg.src.size();
+        dg.ndrop = nrx ? msgs[nrx-1].ndrop : msgs.back().ndrop;
+
+        nsyscall++;
+        // truncation is not detected here
+        int ret = recvfromx(sock, (char*)dg.buf, dg.bufsize-1u, &dg.src->sa, &alen, &dg.ndrop);
+        if(ret<0)
+            break;
+
+        dg.len = size_t(ret);
+        nrx++;
+    }
+    if(nrx==0)
+        return -1;
+
+    npacket += size_t(nrx);
+    msgs.back().ndrop = msgs[nrx-1].ndrop;
+    return nrx;
+#endif
+}
+
+#ifdef __linux__
+#  define USE_SENDMMSG
+#endif
+
+struct UDPTxBatch::Pvt {
+#ifdef USE_SENDMMSG
+    std::vector<mmsghdr> hdrs;
+    std::vector<iovec> iovs;
+#endif
+};
+
+UDPTxBatch::UDPTxBatch()
+    :pvt(new Pvt)
+{}
+
+UDPTxBatch::~UDPTxBatch() {}
+
+void UDPTxBatch::push(const void *msg, size_t msglen, const SockAddr& dest)
+{
+    if(count==msgs.size())
+        msgs.emplace_back();
+
+    auto& dg = msgs[count++];
+    auto bytes = static_cast<const uint8_t*>(msg);
+    dg.buf.assign(bytes, bytes+msglen);
+    dg.dest = dest;
+    dg.ntx = 0;
+    dg.err = 0;
+}
+
+size_t UDPTxBatch::flush(SOCKET sock)
+{
+    size_t nsent = 0u;
+
+#ifdef USE_SENDMMSG
+    pvt->hdrs.resize(count);
+    pvt->iovs.resize(count);
+
+    for(auto i : range(count)) {
+        auto& dg = msgs[i];
+        auto& hdr = pvt->hdrs[i].msg_hdr;
+
+        pvt->iovs[i] = iovec{dg.buf.data(), dg.buf.size()};
+
+        hdr = msghdr{};
+        hdr.msg_iov = &pvt->iovs[i];
+        hdr.msg_iovlen = 1u;
+        hdr.msg_name = &dg.dest->sa;
+        hdr.msg_namelen = dg.dest.size();
+        pvt->hdrs[i].msg_len = 0u;
+    }
+
+    size_t i = 0u;
+    while(i<count) {
+        // kernel limits the number of messages per call.  cf. UIO_MAXIOV
+        auto n = std::min(count-i, size_t(1024u));
+
+        nsyscall++;
+        int ret = sendmmsg(sock, &pvt->hdrs[i], n, 0);
+
+        if(ret<=0) {
+            // error on the first datagram.  skip it and continue with the rest.
+            msgs[i].ntx = -1;
+            msgs[i].err = ret<0 ? SOCKERRNO : 0;
+            i++;
+            continue;
+        }
+
+        for(auto j : range(i, i+size_t(ret))) {
+            msgs[j].ntx = int(pvt->hdrs[j].msg_len);
+            if(msgs[j].buf.size()==pvt->hdrs[j].msg_len)
+                nsent++;
+        }
+        npacket += size_t(ret);
+        i += size_t(ret);
+    }
+
+#else
+    for(auto i : range(count)) {
+        auto& dg = msgs[i];
+
+        nsyscall++;
+        dg.ntx = sendto(sock, (char*)dg.buf.data(), dg.buf.size(), 0, &dg.dest->sa, dg.dest.size());
+        if(dg.ntx<0) {
+            dg.err = SOCKERRNO;
+        } else {
+            npacket++;
+            if(size_t(dg.ntx)==dg.buf.size())
+                nsent++;
+        }
+    }
+#endif
+
+    return nsent;
+}
+
 SockAddr::SockAddr(int af)
 {
     memset(&store, 0, sizeof(store));
@@ -21,6 +21,7 @@
 #include <atomic>
 #include <memory>
 #include <string>
+#include <vector>
 #include <sstream>
 #include <type_traits>
 
@@ -251,6 +252,93 @@ public:
 PVXS_API
 std::ostream& operator<<(std::ostream& strm, const SockAddr& addr);
 
+/* Receive a batch of datagrams.  With one recvmmsg() call where available (Linux).
+ * Otherwise one recvfromx() call per datagram, until an error or capacity() are received.
+ *
+ * Buffers are carved from one slab.  Only the last buffer is large enough for any datagram,
+ * the others for those of up to slotSize-1 bytes, which includes all PVA search and beacon
+ * messages seen in practice.  A larger datagram received into a smaller buffer is truncated,
+ * and so fails to decode.  A batch of 16 needs ~124 KB, instead of ~1 MB.
+ */
+struct PVXS_API UDPRxBatch {
+    static constexpr size_t slotSize = 0x1000;
+
+    struct Datagram {
+        // one byte larger than the largest datagram accepted.  eg. to append a nil.
+        uint8_t* buf = nullptr;
+        size_t bufsize = 0u;
+        SockAddr src;
+        size_t len = 0u;
+        // OS dropped packet counter as of this datagram.  cf. enable_SO_RXQ_OVFL()
+        uint32_t ndrop = 0u;
+    };
+private:
+    std::vector<uint8_t> slab;
+    std::vector<Datagram> msgs;
+    struct Pvt;
+    std::unique_ptr<Pvt> pvt;
+public:
+    // statistics since construction
+    size_t nsyscall = 0u;
+    size_t npacket = 0u;
+    // datagrams larger than their buffer
+    size_t ntrunc = 0u;
+
+    explicit UDPRxBatch(size_t count);
+    ~UDPRxBatch();
+
+    //! maximum number of datagrams per receive()
+    inline size_t capacity() const { return msgs.size(); }
+
+    /* Receive into (*this)[0] through (*this)[ret-1].
+     * Returns -1 on error, eg. when no datagram is pending.
+     * The caller should then inspect evutil_socket_geterror().
+     */
+    int receive(SOCKET sock);
+
+    inline Datagram& operator[](size_t i) { return msgs[i]; }
+};
+
+/* Queue of outgoing UDP datagrams, sent together by flush().
+ * With sendmmsg() where available, otherwise one sendto() each.
+ */
+struct PVXS_API UDPTxBatch {
+    struct Datagram {
+        std::vector<uint8_t> buf;
+        SockAddr dest;
+        // result of last flush().  bytes sent, or -1 with err set
+        int ntx = 0;
+        int err = 0;
+    };
+private:
+    std::vector<Datagram> msgs; // msgs.size()>=count, entries are re-used
+    size_t count = 0u;
+    struct Pvt;
+    std::unique_ptr<Pvt> pvt;
+public:
+    // statistics since construction
+    size_t nsyscall = 0u;
+    size_t npacket = 0u;
+
+    UDPTxBatch();
+    ~UDPTxBatch();
+
+    //! number of datagrams queued
+    inline size_t size() const { return count; }
+
+    //! Queue a copy of msg to be sent to dest
+    void push(const void *msg, size_t msglen, const SockAddr& dest);
+
+    /* Send all queued datagrams.  Returns the number sent completely.
+     * Results are available through (*this)[i] until clear() or push().
+     */
+    size_t flush(SOCKET sock);
+
+    void clear() { count = 0u; }
+
+    inline Datagram& operator[](size_t i) { return msgs[i]; }
+};
+
 template<std::atomic<size_t>* Cnt>
 struct InstCounter
 {
@@ -263,6 +351,8 @@ struct InstCounter
 #define CASE(KLASS) PVXS_API extern std::atomic<size_t> cnt_ ## KLASS
 
 CASE(StructTop);
+CASE(StructTopPoolHit);
+CASE(StructTopPoolMiss);
 
 CASE(UDPListener);
 CASE(evbase);
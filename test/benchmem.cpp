@@ -0,0 +1,88 @@
+/**
+ * Copyright - See the COPYRIGHT that is included with this distribution.
+ * pvxs is distributed subject to a Software License Agreement found
+ * in file LICENSE that is included with this distribution.
+ */
+
+/* Storage bytes per Value for some common NT types.
+ *
+ * Compares the current FieldStorage layout, scalars inline with String/Compound/Array
+ * in StructTop::heavy, against the previous layout with every type inline.
+ * Counts only storage allocated by pvxs for the Value itself.  Not string or array contents.
+ *
+ * Not a unittest.  Run manually.
+ *
+ *   $ ./benchmem
+ */
+
+#include <iostream>
+#include <iomanip>
+
+#include <pvxs/data.h>
+#include <pvxs/nt.h>
+#include <pvxs/log.h>
+#include "dataimpl.h"
+
+namespace {
+using namespace pvxs;
+using namespace pvxs::impl;
+
+// FieldStorage as it was, with all types stored inline
+struct InlineFieldStorage {
+    aligned_union<8,
+                  double,
+                  uint64_t,
+                  std::string,
+                  Value,
+                  shared_array<const void>
+    >::type store;
+    StructTop *top;
+    bool valid;
+    StoreType code;
+};
+
+void show(const char* what, const Value& val)
+{
+    auto top = Value::Helper::store_ptr(val)->top;
+    const size_t nfld = top->members.size();
+    const size_t nheavy = top->heavy.size();
+
+    const size_t before = sizeof(StructTop) - sizeof(top->heavy) + nfld*sizeof(InlineFieldStorage);
+    const size_t after = sizeof(StructTop) + nfld*sizeof(FieldStorage) + nheavy*sizeof(HeavyStorage);
+
+    std::cout<<"  "<<std::setw(22)<<std::left<<what<<std::right
+             <<std::setw(6)<<nfld
+             <<std::setw(8)<<nheavy
+             <<std::setw(10)<<before
+             <<std::setw(10)<<after
+             <<std::setw(9)<<std::fixed<<std::setprecision(1)<<(100.0*after/before)<<" %\n";
+}
+
+} // namespace
+
+int main(int argc, char* argv[])
+{
+    logger_config_env();
+
+    std::cout<<"sizeof(FieldStorage) "<<sizeof(FieldStorage)
+             <<" was "<<sizeof(InlineFieldStorage)
+             <<", sizeof(HeavyStorage) "<<sizeof(HeavyStorage)<<"\n\n"
+             <<"  "<<std::setw(22)<<std::left<<"type"<<std::right
+             <<std::setw(6)<<"fields"
+             <<std::setw(8)<<"heavy"
+             <<std::setw(10)<<"inline"
+             <<std::setw(10)<<"now"
+             <<std::setw(11)<<"ratio"<<"\n";
+
+    show("NTScalar double", nt::NTScalar{TypeCode::Float64}.create());
+    show("NTScalar full double", nt::NTScalar{TypeCode::Float64, true, true, true}.create());
+    show("NTScalar double[]", nt::NTScalar{TypeCode::Float64A}.create());
+    show("NTScalar string", nt::NTScalar{TypeCode::String}.create());
+    show("NTNDArray", nt::NTNDArray{}.create());
+    show("NTURI", nt::NTURI({
+                              Member(TypeCode::String, "pv"),
+                              Member(TypeCode::UInt32, "count"),
+                          }).create());
+
+    return 0;
+}
@@ -0,0 +1,170 @@
+/**
+ * Copyright - See the COPYRIGHT that is included with this distribution.
+ * pvxs is distributed subject to a Software License Agreement found
+ * in file LICENSE that is included with this distribution.
+ */
+
+/* Server search throughput with many PV names, with and without Config::claim_index.
+ *
+ * The names are spread across several StaticSources.  Batches of search requests,
+ * each for several names, are sent over loopback, and replies counted.
+ * Reports names found per second.
+ *
+ * Not a unittest.  Run manually, optionally with the number of names,
+ * and the number of StaticSources.
+ *
+ *   $ ./benchsearch [nnames] [nsources]
+ */
+
+#include <chrono>
+#include <iostream>
+#include <iomanip>
+#include <cstdlib>
+
+#include <osiSock.h>
+
+#include <pvxs/server.h>
+#include <pvxs/sharedpv.h>
+#include <pvxs/log.h>
+#include <pvxs/nt.h>
+#include "evhelper.h"
+#include "utilpvt.h"
+#include "pvaproto.h"
+
+namespace {
+using namespace pvxs;
+
+typedef std::chrono::steady_clock clock_type;
+
+// time to spend on each measurement
+constexpr double runTime = 2.0;
+// names in each search request
+constexpr size_t namesPerReq = 16u;
+// requests sent before waiting for replies
+constexpr size_t window = 32u;
+
+std::string pvname(size_t i)
+{
+    return SB()<<"bench:pv:"<<i;
+}
+
+bool waitReadable(SOCKET sock, double timeout)
+{
+    fd_set fds;
+    FD_ZERO(&fds);
+    FD_SET(sock, &fds);
+    timeval tv{0, long(timeout*1e6)};
+    return select(int(sock)+1, &fds, nullptr, nullptr, &tv)==1;
+}
+
+void bench(bool index, const std::vector<server::StaticSource>& srcs, size_t nnames)
+{
+    auto conf(server::Config::isolated());
+    conf.claim_index = index;
+    auto serv(conf.build());
+    for(auto i : range(srcs.size()))
+        serv.addSource(SB()<<"static"<<i, srcs[i].source());
+    serv.start();
+
+    SockAddr dest(SockAddr::loopback(AF_INET, serv.config().udp_port));
+    SockAddr self(SockAddr::loopback(AF_INET));
+    evsocket sock(AF_INET, SOCK_DGRAM, 0);
+    sock.bind(self);
+
+    // pre-build requests
+    std::vector<std::vector<uint8_t>> reqs(window);
+    size_t next = 0u;
+    for(auto& msg : reqs) {
+        msg.resize(0x10000);
+        VectorOutBuf M(true, msg);
+
+        M.skip(8, __FILE__, __LINE__); // placeholder for header
+        to_wire(M, uint32_t(0x12345678));
+        M.skip(4, __FILE__, __LINE__);
+        to_wire(M, SockAddr::any(AF_INET));
+        to_wire(M, uint16_t(self.port()));
+        to_wire(M, Size{1});
+        to_wire(M, "tcp");
+        to_wire(M, uint16_t(namesPerReq));
+        for(auto i : range(namesPerReq)) {
+            to_wire(M, uint32_t(i));
+            // scatter over all names, and so all sources
+            to_wire(M, pvname((next++ * 7919u)%nnames));
+        }
+
+        auto pktlen = M.save()-msg.data();
+        FixedBuf H(true, msg.data(), 8);
+        to_wire(H, Header{CMD_SEARCH, 0, uint32_t(pktlen-8)});
+        if(!M.good() || !H.good())
+            throw std::logic_error("Unable to encode search");
+        msg.resize(pktlen);
+    }
+
+    std::vector<uint8_t> rx(0x10000);
+    size_t nsent = 0u, nreply = 0u;
+
+    auto start(clock_type::now());
+    double elapsed;
+    do {
+        for(auto& msg : reqs) {
+            if(sendto(sock.sock, (char*)msg.data(), msg.size(), 0, &dest->sa, dest.size())==int(msg.size()))
+                nsent++;
+        }
+
+        for(size_t n=0u; n<window && waitReadable(sock.sock, 0.1); n++) {
+            if(recv(sock.sock, (char*)rx.data(), rx.size(), 0)>0)
+                nreply++;
+        }
+
+        elapsed = std::chrono::duration<double>(clock_type::now() - start).count();
+    } while(elapsed < runTime);
+
+    std::cout<<std::setw(8)<<(index ? "yes" : "no")
+             <<std::setw(14)<<std::fixed<<std::setprecision(0)<<(nreply*namesPerReq/elapsed)
+             <<std::setw(10)<<std::setprecision(1)<<(100.0*(nsent-nreply)/nsent)<<"\n";
+
+    serv.stop();
+}
+
+} // namespace
+
+int main(int argc, char* argv[])
+{
+    SockAttach attach;
+    logger_config_env();
+
+    size_t nnames = 1000000u;
+    size_t nsources = 8u;
+    if(argc>1)
+        nnames = std::strtoul(argv[1], nullptr, 0);
+    if(argc>2)
+        nsources = std::max(size_t(1u), size_t(std::strtoul(argv[2], nullptr, 0)));
+
+    auto initial(nt::NTScalar{TypeCode::Int32}.create());
+    auto pv(server::SharedPV::buildReadonly());
+    pv.open(initial);
+
+    std::vector<server::StaticSource> srcs;
+    for(auto i : range(nsources)) {
+        (void)i;
+        srcs.push_back(server::StaticSource::build());
+    }
+    for(auto i : range(nnames))
+        srcs[i%nsources].add(pvname(i), pv);
+
+    std::cout<<nnames<<" names in "<<nsources<<" StaticSources, "
+             <<namesPerReq<<" names per search\n"
+             <<"index       names/s    lost %\n";
+
+    try {
+        bench(false, srcs, nnames);
+        bench(true, srcs, nnames);
+    }catch(std::exception& e){
+        std::cerr<<"Error: "<<e.what()<<"\n";
+        return 1;
+    }
+
+    for(auto& src : srcs)
+        src.close();
+    return 0;
+}
@@ -0,0 +1,145 @@
+/**
+ * Copyright - See the COPYRIGHT that is included with this distribution.
+ * pvxs is distributed subject to a Software License Agreement found
+ * in file LICENSE that is included with this distribution.
+ */
+
+/* Server monitor throughput vs. the number of TCP worker threads.
+ *
+ * One PV is updated as fast as possible, with each client subscribed.
+ * Reports the total rate of updates delivered to all clients.
+ *
+ * Not a unittest.  Run manually, optionally with the number of clients,
+ * the number of array elements in each update, and the maximum number
+ * of workers (default is the number of CPU cores).
+ *
+ *   $ ./benchserver [nclients] [nelem] [maxworkers]
+ */
+
+#include <atomic>
+#include <chrono>
+#include <iostream>
+#include <iomanip>
+#include <cstdlib>
+
+#include <epicsEvent.h>
+#include <epicsThread.h>
+
+#include <pvxs/client.h>
+#include <pvxs/server.h>
+#include <pvxs/sharedpv.h>
+#include <pvxs/log.h>
+#include <pvxs/nt.h>
+
+namespace {
+using namespace pvxs;
+
+typedef std::chrono::steady_clock clock_type;
+
+// time to spend on each measurement
+constexpr double runTime = 2.0;
+
+void bench(unsigned nworkers, size_t nclients, const Value& initial, size_t nbytes)
+{
+    auto pv(server::SharedPV::buildReadonly());
+    pv.open(initial);
+
+    auto conf(server::Config::isolated());
+    conf.tcp_workers = nworkers;
+    auto serv(conf.build()
+              .addPV("bench", pv)
+              .start());
+
+    std::atomic<size_t> nupdate{0u};
+    std::atomic<size_t> nconnected{0u};
+    epicsEvent ready;
+
+    std::vector<client::Context> clis;
+    std::vector<std::shared_ptr<client::Subscription>> subs;
+    clis.reserve(nclients);
+    subs.reserve(nclients);
+    for(size_t i=0; i<nclients; i++) {
+        clis.push_back(serv.clientConfig().build());
+        subs.push_back(clis.back().monitor("bench")
+                       .maskConnected(false)
+                       .event([&nupdate, &nconnected, &ready, nclients](client::Subscription& sub) {
+                           // drain the queue completely, or no further events are delivered
+                           while(true) {
+                               try {
+                                   if(!sub.pop())
+                                       break;
+                                   nupdate++;
+                               }catch(client::Connected&){
+                                   if(++nconnected==nclients)
+                                       ready.signal();
+                               }catch(std::exception& e){
+                                   std::cerr<<"Error: "<<e.what()<<"\n";
+                               }
+                           }
+                       })
+                       .exec());
+    }
+
+    if(!ready.wait(10.0))
+        throw std::runtime_error("Timeout connecting");
+
+    auto update(initial.cloneEmpty());
+    update["value"] = initial["value"].as<shared_array<const void>>();
+
+    nupdate = 0u;
+    auto start(clock_type::now());
+    double elapsed;
+    do {
+        pv.post(update);
+        elapsed = std::chrono::duration<double>(clock_type::now() - start).count();
+    } while(elapsed < runTime);
+    size_t count = nupdate;
+
+    std::cout<<std::setw(8)<<nworkers
+             <<std::setw(14)<<std::fixed<<std::setprecision(0)<<(count/elapsed)
+             <<std::setw(12)<<std::setprecision(1)<<(count*nbytes/elapsed/1e6)<<"\n";
+
+    subs.clear();
+    clis.clear();
+    serv.stop();
+    pv.close();
+}
+
+} // namespace
+
+int main(int argc, char* argv[])
+{
+    // updates in flight when subscriptions are cancelled are logged as errors
+    logger_level_set("pvxs.client.io", Level::Crit);
+    logger_config_env();
+
+    size_t nclients = 16u;
+    size_t nelem = 1024u;
+    unsigned maxworkers = std::max(1, epicsThreadGetCPUs());
+    if(argc>1)
+        nclients = std::strtoul(argv[1], nullptr, 0);
+    if(argc>2)
+        nelem = std::strtoul(argv[2], nullptr, 0);
+    if(argc>3)
+        maxworkers = std::strtoul(argv[3], nullptr, 0);
+
+    auto initial(nt::NTScalar{TypeCode::Float64A}.create());
+    {
+        shared_array<double> arr(nelem);
+        for(size_t i=0; i<nelem; i++)
+            arr[i] = double(i);
+        initial["value"] = arr.freeze().castTo<const void>();
+    }
+
+    std::cout<<nclients<<" clients, "<<nelem<<" element array\n"
+             <<"workers     updates/s        MB/s\n";
+
+    try {
+        for(unsigned nworkers = 1u; nworkers <= maxworkers; nworkers *= 2u)
+            bench(nworkers, nclients, initial, nelem*sizeof(double));
+    }catch(std::exception& e){
+        std::cerr<<"Error: "<<e.what()<<"\n";
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,113 @@
+/**
+ * Copyright - See the COPYRIGHT that is included with this distribution.
+ * pvxs is distributed subject to a Software License Agreement found
+ * in file LICENSE that is included with this distribution.
+ */
+
+/* Flood the UDPCollector with search requests over loopback.
+ * Reports receive rate and loss.  The OS may legitimately drop some fraction.
+ *
+ * Not a unittest.  Run manually, optionally with the number of requests to send.
+ *
+ *   $ ./benchudp [nsend]
+ */
+
+#include <atomic>
+#include <iostream>
+#include <iomanip>
+#include <cstdlib>
+
+#include <osiSock.h>
+#include <epicsEvent.h>
+#include <epicsTime.h>
+
+#include <pvxs/log.h>
+#include "evhelper.h"
+#include "utilpvt.h"
+#include "pvaproto.h"
+#include "udp_collector.h"
+
+namespace {
+using namespace pvxs;
+
+void bench(size_t nsend)
+{
+    SockAddr listener(SockAddr::loopback(AF_INET));
+    SockAddr sender(SockAddr::loopback(AF_INET));
+
+    evsocket sock(AF_INET, SOCK_DGRAM, 0);
+    sock.bind(sender);
+
+    std::atomic<size_t> nrx{0u};
+    epicsEvent done;
+
+    auto manager = UDPManager::instance();
+    auto sub = manager.onSearch(listener, [&nrx, &done, nsend](const UDPManager::Search&)
+    {
+        if(nrx.fetch_add(1u)+1u==nsend)
+            done.signal();
+    });
+    sub->start();
+
+    std::vector<uint8_t> msg(1024, 0);
+    VectorOutBuf M(true, msg);
+
+    M.skip(8, __FILE__, __LINE__); // placeholder for header
+    to_wire(M, uint32_t(0x12345678));
+    M.skip(4, __FILE__, __LINE__);
+    to_wire(M, SockAddr::any(AF_INET));
+    to_wire(M, uint16_t(0x1020));
+    to_wire(M, Size{1});
+    to_wire(M, "tcp");
+    to_wire(M, uint16_t(1u));
+    to_wire(M, uint32_t(1u));
+    to_wire(M, "stress:pv");
+
+    auto pktlen = M.save()-msg.data();
+
+    FixedBuf H(true, msg.data(), 8);
+    to_wire(H, Header{CMD_SEARCH, 0, uint32_t(pktlen-8)});
+    if(!M.good() || !H.good())
+        throw std::logic_error("Unable to encode search");
+
+    epicsTime start(epicsTime::getCurrent());
+
+    size_t nsent = 0u;
+    for(auto i : range(nsend)) {
+        (void)i;
+        if(sendto(sock.sock, (char*)msg.data(), pktlen, 0, &listener->sa, listener.size())==int(pktlen))
+            nsent++;
+    }
+
+    manager.sync();
+    // any packets not received by now were probably dropped
+    (void)done.wait(5.0);
+
+    double elapsed = epicsTime::getCurrent() - start;
+    size_t nrecv = nrx.load();
+
+    std::cout<<"Sent "<<nsent<<"/"<<nsend<<", received "<<nrecv
+             <<" in "<<std::fixed<<std::setprecision(3)<<elapsed<<" sec.  "
+             <<std::setprecision(0)<<(nrecv/elapsed)<<" pkt/s, "
+             <<std::setprecision(2)<<(nsent ? 100.0*(nsent-nrecv)/nsent : 0.0)<<" % dropped\n";
+}
+
+} // namespace
+
+int main(int argc, char* argv[])
+{
+    SockAttach attach;
+    logger_config_env();
+
+    size_t nsend = 20000u;
+    if(argc>1)
+        nsend = std::strtoul(argv[1], nullptr, 0);
+
+    try {
+        bench(nsend);
+    }catch(std::exception& e){
+        std::cerr<<"Error: "<<e.what()<<"\n";
+        return 1;
+    }
+    return 0;
+}
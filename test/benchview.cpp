@@ -0,0 +1,106 @@
+/**
+ * Copyright - See the COPYRIGHT that is included with this distribution.
+ * pvxs is distributed subject to a Software License Agreement found
+ * in file LICENSE that is included with this distribution.
+ */
+
+/* Cost of filling an NTScalar update, by field name, by FieldPath, and by StructView.
+ *
+ * Not a unittest.  Run manually.
+ *
+ *   $ ./benchview
+ */
+
+#include <chrono>
+#include <iostream>
+#include <iomanip>
+
+#include <pvxs/data.h>
+#include <pvxs/nt.h>
+#include <pvxs/log.h>
+
+namespace {
+using namespace pvxs;
+
+typedef std::chrono::steady_clock clock_type;
+
+// minimum time to spend on each measurement
+constexpr double minTime = 1.0;
+
+// repeat fn() until minTime has passed.  return average time per call in seconds
+template<typename Fn>
+double timeit(Fn&& fn)
+{
+    size_t count = 0u;
+    auto start(clock_type::now());
+    double elapsed;
+    do {
+        for(unsigned i=0; i<1000u; i++)
+            fn(count++);
+        elapsed = std::chrono::duration<double>(clock_type::now() - start).count();
+    } while(elapsed < minTime);
+    return elapsed/count;
+}
+
+void show(const char* what, double tper)
+{
+    std::cout<<"  "<<std::setw(12)<<std::left<<what<<std::right
+             <<std::setw(10)<<std::fixed<<std::setprecision(1)<<(tper*1e9)<<" ns/update\n";
+}
+
+struct Sample {
+    double value;
+    int32_t severity;
+    int32_t status;
+    int64_t sec;
+    int32_t nsec;
+};
+
+} // namespace
+
+int main(int argc, char* argv[])
+{
+    logger_config_env();
+
+    auto proto(nt::NTScalar{TypeCode::Float64}.create());
+    // reused, as a server would post() each update then fill the next
+    auto update(proto.cloneEmpty());
+
+    std::cout<<"Fill 5 fields of NTScalar\n";
+
+    show("by name", timeit([&update](size_t i) {
+        update["value"] = double(i);
+        update["alarm.severity"] = int32_t(i&3);
+        update["alarm.status"] = int32_t(0);
+        update["timeStamp.secondsPastEpoch"] = int64_t(i);
+        update["timeStamp.nanoseconds"] = int32_t(i);
+    }));
+
+    FieldPath value(proto, "value"),
+              sevr(proto, "alarm.severity"),
+              stat(proto, "alarm.status"),
+              sec(proto, "timeStamp.secondsPastEpoch"),
+              nsec(proto, "timeStamp.nanoseconds");
+
+    show("FieldPath", timeit([&](size_t i) {
+        update[value] = double(i);
+        update[sevr] = int32_t(i&3);
+        update[stat] = int32_t(0);
+        update[sec] = int64_t(i);
+        update[nsec] = int32_t(i);
+    }));
+
+    StructView<Sample> view(proto);
+    view.bind("value", &Sample::value)
+        .bind("alarm.severity", &Sample::severity)
+        .bind("alarm.status", &Sample::status)
+        .bind("timeStamp.secondsPastEpoch", &Sample::sec)
+        .bind("timeStamp.nanoseconds", &Sample::nsec);
+
+    show("StructView", timeit([&view, &update](size_t i) {
+        Sample sample{double(i), int32_t(i&3), 0, int64_t(i), int32_t(i)};
+        view.store(update, sample);
+    }));
+
+    return 0;
+}
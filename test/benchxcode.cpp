@@ -0,0 +1,225 @@
+/**
+ * Copyright - See the COPYRIGHT that is included with this distribution.
+ * pvxs is distributed subject to a Software License Agreement found
+ * in file LICENSE that is included with this distribution.
+ */
+
+/* Throughput of (de)serialization of large arrays.
+ * And cost of encoding partial updates with, and without, an EncodePlan.
+ *
+ * Not a unittest.  Run manually, optionally with the array size in bytes.
+ *
+ *   $ ./benchxcode [nbytes]
+ */
+
+#include <chrono>
+#include <iostream>
+#include <iomanip>
+#include <cstdlib>
+
+#include <pvxs/data.h>
+#include <pvxs/nt.h>
+#include <pvxs/log.h>
+#include "dataimpl.h"
+#include "evhelper.h"
+#include "pvaproto.h"
+
+namespace {
+using namespace pvxs;
+
+typedef std::chrono::steady_clock clock_type;
+
+// minimum time to spend on each measurement
+constexpr double minTime = 0.5;
+
+// repeat fn() until minTime has passed.  return average time per call in seconds
+template<typename Fn>
+double timeit(Fn&& fn)
+{
+    size_t count = 0u;
+    auto start(clock_type::now());
+    double elapsed;
+    do {
+        fn();
+        count++;
+        elapsed = std::chrono::duration<double>(clock_type::now() - start).count();
+    } while(elapsed < minTime);
+    return elapsed/count;
+}
+
+// element by element, as was done prior to bulk copy
+template<typename E>
+void to_wire_each(Buffer& buf, const shared_array<const E>& arr)
+{
+    to_wire(buf, Size{arr.size()});
+    for(auto i : range(arr.size()))
+        to_wire(buf, arr[i]);
+}
+
+template<typename E>
+void from_wire_each(Buffer& buf, shared_array<E>& arr)
+{
+    Size slen{};
+    from_wire(buf, slen);
+    for(auto i : range(slen.size))
+        from_wire(buf, arr[i]);
+}
+
+void show(const char* what, bool be, size_t nbytes, double tper)
+{
+    std::cout<<"  "<<std::setw(16)<<std::left<<what<<std::right
+             <<(be==hostBE ? " native " : " swapped")
+             <<std::setw(10)<<std::fixed<<std::setprecision(3)<<(nbytes/tper/1e9)<<" GB/s\n";
+}
+
+template<typename E>
+void bench(size_t nbytes)
+{
+    const size_t nelem = nbytes/sizeof(E);
+    nbytes = nelem*sizeof(E);
+
+    std::cout<<detail::CaptureBase<E>::code<<"[] "<<nelem<<" elements\n";
+
+    shared_array<E> input(nelem);
+    for(auto i : range(nelem))
+        input[i] = E(i);
+    auto arr(input.freeze());
+
+    TypeDef def(TypeCode::Struct, {Member(TypeCode(ScalarMap<E>::code).arrayOf(), "value")});
+    auto val(def.create());
+    val["value"] = arr;
+
+    evbuf encoded(evbuffer_new());
+
+    for(auto be : {hostBE, !hostBE}) {
+        // encode, and discard
+        show("to_wire_valid", be, nbytes, timeit([&]() {
+            {
+                EvOutBuf M(be, encoded.get());
+                to_wire_valid(M, val);
+                if(!M.good())
+                    throw std::logic_error("Encode error");
+            }
+            evbuffer_drain(encoded.get(), evbuffer_get_length(encoded.get()));
+        }));
+
+        show("to_wire (each)", be, nbytes, timeit([&]() {
+            {
+                EvOutBuf M(be, encoded.get());
+                to_wire_each(M, arr);
+            }
+            evbuffer_drain(encoded.get(), evbuffer_get_length(encoded.get()));
+        }));
+
+        // encode once for repeated decode
+        std::vector<uint8_t> flat;
+        {
+            VectorOutBuf M(be, flat);
+            to_wire_valid(M, val);
+            flat.resize(M.consumed());
+        }
+
+        show("from_wire_valid", be, nbytes, timeit([&]() {
+            TypeStore ctxt;
+            auto out(val.cloneEmpty());
+            FixedBuf M(be, flat);
+            from_wire_valid(M, ctxt, out);
+            if(!M.good() || !M.empty())
+                throw std::logic_error("Decode error");
+        }));
+
+        shared_array<E> scratch(nelem);
+        show("from_wire (each)", be, nbytes, timeit([&]() {
+            FixedBuf M(be, flat);
+            M._skip(2u); // BitMask
+            from_wire_each(M, scratch);
+        }));
+    }
+}
+
+void showUpdate(const char* what, double tper)
+{
+    std::cout<<"  "<<std::setw(16)<<std::left<<what<<std::right
+             <<std::setw(10)<<std::fixed<<std::setprecision(1)<<(tper*1e9)<<" ns/update\n";
+}
+
+// encode val, through a pvRequest mask of every other field
+void benchUpdate(const char* what, const Value& val)
+{
+    auto desc = Value::Helper::desc(val);
+    BitMask mask(desc->size());
+    for(auto i : range(desc->size()))
+        mask[i] = (i%2u)==0u;
+
+    EncodePlan plan;
+    plan.reset(desc, &mask);
+
+    std::cout<<what<<" "<<desc->size()<<" fields\n";
+
+    evbuf encoded(evbuffer_new());
+
+    showUpdate("to_wire_valid", timeit([&]() {
+        {
+            EvOutBuf M(hostBE, encoded.get());
+            to_wire_valid(M, val, &mask);
+        }
+        evbuffer_drain(encoded.get(), evbuffer_get_length(encoded.get()));
+    }));
+
+    showUpdate("EncodePlan", timeit([&]() {
+        {
+            EvOutBuf M(hostBE, encoded.get());
+            to_wire_valid(M, val, plan);
+        }
+        evbuffer_drain(encoded.get(), evbuffer_get_length(encoded.get()));
+    }));
+}
+
+void benchUpdates()
+{
+    {
+        auto val(nt::NTScalar{TypeCode::Float64}.create());
+        val["value"] = 1.0;
+        val["alarm.severity"] = 0;
+        val["timeStamp.secondsPastEpoch"] = 1234;
+        val["timeStamp.nanoseconds"] = 5678;
+        benchUpdate("NTScalar", val);
+    }
+    {
+        TypeDef def(TypeCode::Struct, {});
+        std::vector<Member> members;
+        for(auto i : range(500u))
+            members.push_back(Member(i%3u ? TypeCode::Float64 : TypeCode::Int32, std::string(SB()<<"f"<<i)));
+        def += members;
+        auto val(def.create());
+        // mark every third field
+        for(unsigned i=0u; i<500u; i+=3u)
+            val[std::string(SB()<<"f"<<i)] = 1;
+        benchUpdate("Struct", val);
+    }
+}
+
+} // namespace
+
+int main(int argc, char* argv[])
+{
+    logger_config_env();
+
+    size_t nbytes = 16u<<20u;
+    if(argc>1)
+        nbytes = std::strtoul(argv[1], nullptr, 0);
+
+    try {
+        bench<int8_t>(nbytes);
+        bench<uint16_t>(nbytes);
+        bench<int32_t>(nbytes);
+        bench<float>(nbytes);
+        bench<int64_t>(nbytes);
+        bench<double>(nbytes);
+        benchUpdates();
+    }catch(std::exception& e){
+        std::cerr<<"Error: "<<e.what()<<"\n";
+        return 1;
+    }
+    return 0;
+}
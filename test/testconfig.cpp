@@ -79,11 +79,13 @@ void testDefs()
         client::Config conf;
 
         conf.udp_port = 1234;
+        conf.tcp_port = 5678;
         conf.interfaces = {"1.2.3.4", "1.1.1.1"};
         conf.addressList = {"1.2.1.2", "4.3.2.1:1234"};
         conf.autoAddrList = false;
         conf.updateDefs(defs);
         testEq(defs["EPICS_PVA_BROADCAST_PORT"], "1234");
+        testEq(defs["EPICS_PVA_SERVER_PORT"], "5678");
         testEq(defs["EPICS_PVA_AUTO_ADDR_LIST"], "NO");
         testEq(defs["EPICS_PVA_ADDR_LIST"], "1.2.1.2 4.3.2.1:1234");
         testEq(defs["EPICS_PVA_INTF_ADDR_LIST"], "1.2.3.4 1.1.1.1");
@@ -94,11 +96,13 @@ void testDefs()
         client::Config conf;
 
         defs["EPICS_PVA_BROADCAST_PORT"] = "1234";
+        defs["EPICS_PVA_SERVER_PORT"] = "5678";
         defs["EPICS_PVA_AUTO_ADDR_LIST"] = "NO";
         defs["EPICS_PVA_ADDR_LIST"] = "1.2.1.2 4.3.2.1:1234";
         defs["EPICS_PVA_INTF_ADDR_LIST"] = "1.2.3.4 1.1.1.1";
         conf.applyDefs(defs);
         testEq(conf.udp_port, 1234);
+        testEq(conf.tcp_port, 5678);
         testFalse(conf.autoAddrList);
         testEq(conf.addressList, std::vector<std::string>({"1.2.1.2:1234", "4.3.2.1:1234"}));
         testEq(conf.interfaces, std::vector<std::string>({"1.2.3.4", "1.1.1.1"}));
@@ -149,7 +153,7 @@ void testDefs()
 
 MAIN(testconfig)
 {
-    testPlan(27);
+    testPlan(29);
     testSetup();
     testDefs();
     logger_config_env();
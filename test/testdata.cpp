@@ -309,11 +309,210 @@ void testAssignSimilar()
     }
 }
 
+void testAssignSame()
+{
+    testShow()<<__func__;
+
+    auto def = TypeDef(TypeCode::Struct, {
+                           members::Float64A("value"),
+                           members::Struct("alarm", {
+                               members::Int32("severity"),
+                               members::String("message"),
+                           }),
+                           members::Union("choice", {
+                               members::Int32("i"),
+                               members::String("s"),
+                           }),
+                           members::String("desc"),
+                       });
+
+    auto val1 = def.create();
+    auto val2 = def.create();
+
+    shared_array<const double> arr({1.0, 2.0});
+    val2["value"] = arr;
+    val2["alarm.severity"] = 1;
+    val2["choice->s"] = "hello";
+
+    val1.assign(val2);
+    testTrue(val1["value"].isMarked());
+    testEq(val1["value"].as<shared_array<const double>>().data(), arr.data());
+    testFalse(val1["alarm"].isMarked());
+    testTrue(val1["alarm.severity"].isMarked());
+    testEq(val1["alarm.severity"].as<int32_t>(), 1);
+    testFalse(val1["alarm.message"].isMarked());
+    testEq(val1["choice"].as<std::string>(), "hello");
+    testFalse(val1["desc"].isMarked());
+
+    val1.unmark();
+    val2.unmark();
+    val2["alarm.message"] = "oops";
+    val2["alarm"].mark();
+
+    val1.assign(val2);
+    testFalse(val1["value"].isMarked());
+    testTrue(val1["alarm"].isMarked());
+    testTrue(val1["alarm.severity"].isMarked());
+    testTrue(val1["alarm.message"].isMarked());
+    testEq(val1["alarm.message"].as<std::string>(), "oops");
+
+    // clone() copies storage, so the original may be changed afterwards
+    auto val3 = val2.clone();
+    val2["alarm.message"] = "changed";
+    testEq(val3["alarm.message"].as<std::string>(), "oops");
+    // only marked fields are copied
+    testFalse(val3["choice"].isMarked());
+
+    // masked, as for a subscription with pvRequest "field(alarm.severity)"
+    auto val4 = def.create();
+    auto val5 = def.create();
+    val5["value"] = arr;
+    val5["alarm.severity"] = 2;
+    val5["desc"] = "ignored";
+    BitMask mask({0u, 2u, 3u}, 7u);
+
+    Value::Helper::assignSame(val4, val5, &mask);
+    testFalse(val4["value"].isMarked());
+    testTrue(val4["alarm.severity"].isMarked());
+    testEq(val4["alarm.severity"].as<int32_t>(), 2);
+    testFalse(val4["desc"].isMarked());
+}
+
+void testFieldPath()
+{
+    testShow()<<__func__;
+
+    auto def = nt::NTScalar{TypeCode::Int32}.build();
+    auto proto = def.create();
+
+    FieldPath value(proto, "value"), sevr(proto, "alarm.severity");
+    testEq(sevr.name(), "alarm.severity");
+
+    auto val = proto.cloneEmpty();
+    val[value] = 42;
+    val[sevr] = 2;
+    testEq(val["value"].as<int32_t>(), 42);
+    testEq(val["alarm.severity"].as<int32_t>(), 2);
+    testTrue(val[sevr].equalInst(val["alarm.severity"]));
+
+    // equivalent, but distinct, type uses lookup by name
+    auto other = def.create();
+    other[sevr] = 3;
+    testEq(other["alarm.severity"].as<int32_t>(), 3);
+
+    auto unrelated = nt::NTScalar{TypeCode::String}.create();
+    unrelated[value] = "hello";
+    testEq(unrelated["value"].as<std::string>(), "hello");
+
+    testFalse(TypeDef(TypeCode::Struct, {}).create()[sevr].valid());
+    testFalse(val[FieldPath()].valid());
+
+    testThrows<LookupError>([&proto]() {
+        FieldPath(proto, "nonexistent");
+    });
+    testThrows<LookupError>([&proto]() {
+        FieldPath(proto["value"], "value");
+    });
+}
+
+struct Sample {
+    double value;
+    int32_t severity;
+    int64_t sec;
+    std::string desc;
+};
+
+void testStructView()
+{
+    testShow()<<__func__;
+
+    auto proto = nt::NTScalar{TypeCode::Float64, true}.create();
+
+    StructView<Sample> view(proto);
+    view.bind("value", &Sample::value)
+        .bind("alarm.severity", &Sample::severity)
+        .bind("timeStamp.secondsPastEpoch", &Sample::sec)
+        .bind("display.description", &Sample::desc);
+
+    Sample in{4.5, 2, 1234, "hello"};
+    auto val = proto.cloneEmpty();
+    view.store(val, in);
+
+    testTrue(val["value"].isMarked());
+    testTrue(val["alarm.severity"].isMarked());
+    testFalse(val["alarm.status"].isMarked());
+    testEq(val["value"].as<double>(), 4.5);
+    testEq(val["alarm.severity"].as<int32_t>(), 2);
+    testEq(val["timeStamp.secondsPastEpoch"].as<int64_t>(), 1234);
+    testEq(val["display.description"].as<std::string>(), "hello");
+
+    val["alarm.severity"] = 3;
+    Sample out{};
+    view.load(out, val);
+    testEq(out.value, 4.5);
+    testEq(out.severity, 3);
+    testEq(out.sec, 1234);
+    testEq(out.desc, "hello");
+
+    {
+        struct Arr { shared_array<const double> value; };
+        auto aproto = nt::NTScalar{TypeCode::Float64A}.create();
+        StructView<Arr> aview(aproto);
+        aview.bind("value", &Arr::value);
+
+        shared_array<double> arr({1.0, 2.0});
+        Arr ain{arr.freeze()};
+        auto aval = aproto.cloneEmpty();
+        aview.store(aval, ain);
+        testEq(aval["value"].as<shared_array<const double>>().size(), 2u);
+    }
+
+    testThrows<LookupError>([&view]() {
+        view.bind("nonexistent", &Sample::value);
+    });
+    testThrows<NoConvert>([&view]() {
+        view.bind("alarm.severity", &Sample::sec); // Int32 vs. int64_t
+    });
+    testThrows<std::logic_error>([&view, &in]() {
+        auto other = nt::NTScalar{TypeCode::Int32}.create();
+        view.store(other, in);
+    });
+}
+
+void testPool()
+{
+    testShow()<<__func__;
+
+    auto def = nt::NTScalar{TypeCode::String}.build();
+    auto val = def.create();
+
+    auto before = instanceSnapshot();
+
+    {
+        auto temp = val.cloneEmpty();
+        temp["value"] = "Testing";
+        temp["alarm.severity"] = 3;
+    }
+    // reuses storage of temp
+    auto val2 = val.cloneEmpty();
+
+    auto after = instanceSnapshot();
+
+    testEq(after["StructTopPoolMiss"] - before["StructTopPoolMiss"], 1u);
+    testEq(after["StructTopPoolHit"] - before["StructTopPoolHit"], 1u);
+
+    // recycled storage is reset
+    testFalse(val2.isMarked(true, true));
+    testEq(val2["value"].as<std::string>(), "");
+    testEq(val2["alarm.severity"].as<int32_t>(), 0);
+    testTrue(val2.equalType(val));
+}
+
 } // namespace
 
 MAIN(testdata)
 {
-    testPlan(108);
+    testPlan(158);
     testSetup();
     testTraverse();
     testAssign();
@@ -356,6 +555,10 @@ MAIN(testdata)
     testConvertScalar2<int32_t, uint64_t, int64_t>(0, 0x100000000llu, -0);
 
     testAssignSimilar();
+    testAssignSame();
+    testFieldPath();
+    testStructView();
+    testPool();
     cleanup_for_valgrind();
     return testDone();
 }
@@ -4,9 +4,13 @@
  * in file LICENSE that is included with this distribution.
  */
 
+#include <chrono>
+#include <vector>
+
 #include <testMain.h>
 
 #include <epicsUnitTest.h>
+#include <epicsThread.h>
 
 #include <pvxs/unittest.h>
 #include <pvxs/log.h>
@@ -67,6 +71,93 @@ void test_call()
 
 }
 
+void test_dispatch_order()
+{
+    testDiag("%s", __func__);
+
+    evbase base("TEST");
+
+    std::vector<unsigned> actual;
+    for(auto i : range(1000u)) {
+        base.dispatch([&actual, i]() {
+            actual.push_back(i);
+        });
+    }
+    base.sync();
+
+    bool inorder = actual.size()==1000u;
+    for(auto i : range(actual.size())) {
+        if(actual[i]!=i) {
+            testDiag("[%u] %u", unsigned(i), actual[i]);
+            inorder = false;
+            break;
+        }
+    }
+    testOk(inorder, "dispatch() executes in FIFO order");
+}
+
+struct Producer : public epicsThreadRunable
+{
+    const evbase& base;
+    size_t& count;
+    const size_t n;
+    epicsThread worker;
+
+    Producer(const evbase& base, size_t& count, size_t n)
+        :base(base)
+        ,count(count)
+        ,n(n)
+        ,worker(*this, "producer",
+                epicsThreadGetStackSize(epicsThreadStackSmall),
+                epicsThreadPriorityMedium)
+    {}
+    virtual ~Producer() {}
+
+    virtual void run() override final
+    {
+        auto& cnt = count;
+        for(auto i : range(n)) {
+            (void)i;
+            base.dispatch([&cnt]() {
+                cnt++;
+            });
+        }
+    }
+};
+
+// Not a strict test.  Reports dispatch() throughput with concurrent producers.
+void test_dispatch_rate()
+{
+    testDiag("%s", __func__);
+
+    constexpr size_t n = 100000u;
+
+    evbase base("TEST");
+
+    for(size_t nthreads : {1u, 2u, 4u}) {
+        // only accessed from worker
+        size_t count = 0u;
+
+        std::vector<std::unique_ptr<Producer>> producers;
+        for(auto i : range(nthreads)) {
+            (void)i;
+            producers.emplace_back(new Producer(base, count, n));
+        }
+
+        auto start(std::chrono::steady_clock::now());
+        for(auto& prod : producers)
+            prod->worker.start();
+        for(auto& prod : producers)
+            prod->worker.exitWait();
+        base.sync();
+        double elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+        testEq(count, nthreads*n);
+        testDiag("%u producers: %.0f dispatch/sec",
+                 unsigned(nthreads), (nthreads*n)/elapsed);
+    }
+}
+
 void test_fill_evbuf()
 {
     testDiag("%s", __func__);
@@ -116,9 +207,11 @@ void test_fill_evbuf()
 MAIN(testev)
 {
     SockAttach attach;
-    testPlan(15);
+    testPlan(19);
     testSetup();
     test_call();
+    test_dispatch_order();
+    test_dispatch_rate();
     test_fill_evbuf();
     cleanup_for_valgrind();
     return testDone();
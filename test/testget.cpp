@@ -5,12 +5,18 @@
  */
 
 #include <atomic>
+#include <map>
+#include <set>
+#include <cmath>
 
 #include <testMain.h>
 
 #include <epicsUnitTest.h>
 
 #include <epicsEvent.h>
+#include <epicsThread.h>
+#include <epicsMutex.h>
+#include <epicsTime.h>
 
 #include <pvxs/unittest.h>
 #include <pvxs/log.h>
@@ -19,6 +25,7 @@
 #include <pvxs/sharedpv.h>
 #include <pvxs/source.h>
 #include <pvxs/nt.h>
+#include "utilpvt.h"
 
 namespace {
 using namespace pvxs;
@@ -252,11 +259,609 @@ void testError(bool phase)
     }
 }
 
+// connections from several clients spread over several server workers
+void testWorkers()
+{
+    testShow()<<__func__;
+
+    auto initial(nt::NTScalar{TypeCode::Int32}.create());
+    initial["value"] = 42;
+
+    auto mbox(server::SharedPV::buildReadonly());
+    mbox.open(initial);
+
+    auto conf(server::Config::isolated());
+    conf.tcp_workers = 3u;
+    auto serv = conf.build()
+            .addPV("mailbox", mbox)
+            .start();
+    testEq(serv.config().tcp_workers, 3u);
+
+    std::vector<client::Context> clis;
+    for(size_t i=0; i<4u; i++)
+        clis.push_back(serv.clientConfig().build());
+
+    for(auto& cli : clis) {
+        client::Result actual;
+        epicsEvent done;
+
+        auto op = cli.get("mailbox")
+                .result([&actual, &done](client::Result&& result) {
+                    actual = std::move(result);
+                    done.signal();
+                })
+                .exec();
+
+        cli.hurryUp();
+
+        if(done.wait(5.0)) {
+            testEq(actual()["value"].as<int32_t>(), 42);
+        } else {
+            testFail("timeout");
+        }
+    }
+}
+
+void testClientWorkers()
+{
+    testShow()<<__func__;
+
+    auto initial(nt::NTScalar{TypeCode::Int32}.create());
+
+    auto servconf(server::Config::isolated());
+    auto builder(servconf.build());
+
+    std::vector<server::SharedPV> pvs;
+    for(int32_t i=0; i<6; i++) {
+        auto pv(server::SharedPV::buildReadonly());
+        auto val(initial.cloneEmpty());
+        val["value"] = i;
+        pv.open(val);
+        builder.addPV("pv"+std::to_string(i), pv);
+        pvs.push_back(pv);
+    }
+
+    auto serv(builder.start());
+
+    auto cliconf(serv.clientConfig());
+    cliconf.tcp_workers = 3u;
+    auto cli(cliconf.build());
+    testEq(cli.config().tcp_workers, 3u);
+
+    std::vector<std::shared_ptr<client::Operation>> ops;
+    std::vector<client::Result> actual(pvs.size());
+    std::vector<epicsEvent> done(pvs.size());
+
+    for(size_t i=0; i<pvs.size(); i++) {
+        ops.push_back(cli.get("pv"+std::to_string(i))
+                      .result([&actual, &done, i](client::Result&& result) {
+                          actual[i] = std::move(result);
+                          done[i].signal();
+                      })
+                      .exec());
+    }
+
+    cli.hurryUp();
+
+    for(size_t i=0; i<pvs.size(); i++) {
+        if(done[i].wait(5.0)) {
+            testEq(actual[i]()["value"].as<int32_t>(), int32_t(i));
+        } else {
+            testFail("timeout pv%u", unsigned(i));
+        }
+    }
+}
+
+// records when each name is searched.  Claims, and serves, only names added through serve()
+struct SearchCounter : public server::Source
+{
+    // when set, onList() returns the served names
+    const bool listed;
+    epicsMutex lock;
+    size_t nrequest = 0u;
+    std::map<std::string, std::vector<epicsTime>> searched;
+    std::map<std::string, server::SharedPV> pvs;
+    std::shared_ptr<const std::set<std::string>> names;
+
+    explicit SearchCounter(bool listed=false) :listed(listed) {}
+
+    void serve(const std::string& name, const server::SharedPV& pv)
+    {
+        epicsGuard<epicsMutex> G(lock);
+        pvs.emplace(name, pv);
+
+        auto temp(std::make_shared<std::set<std::string>>());
+        for(auto& pair : pvs)
+            temp->emplace(pair.first);
+        names = std::move(temp);
+    }
+
+    // number of search requests (datagrams)
+    size_t requests()
+    {
+        epicsGuard<epicsMutex> G(lock);
+        return nrequest;
+    }
+
+    std::vector<epicsTime> times(const std::string& name)
+    {
+        epicsGuard<epicsMutex> G(lock);
+        auto it(searched.find(name));
+        return it==searched.end() ? std::vector<epicsTime>() : it->second;
+    }
+
+    virtual void onSearch(Search &op) override final
+    {
+        const epicsTime now(epicsTime::getCurrent());
+        epicsGuard<epicsMutex> G(lock);
+        nrequest++;
+        for(auto& name : op) {
+            searched[name.name()].push_back(now);
+            if(pvs.find(name.name())!=pvs.end())
+                name.claim();
+        }
+    }
+    virtual void onCreate(std::unique_ptr<server::ChannelControl> &&op) override final
+    {
+        epicsGuard<epicsMutex> G(lock);
+        auto it(pvs.find(op->name()));
+        if(it!=pvs.end())
+            it->second.attach(std::move(op));
+    }
+    virtual List onList() override final
+    {
+        epicsGuard<epicsMutex> G(lock);
+        List ret;
+        ret.names = listed ? names : nullptr;
+        ret.dynamic = false;
+        return ret;
+    }
+};
+
+// searches answered through Config::claim_index
+void testClaimIndex()
+{
+    testShow()<<__func__;
+
+    auto initial(nt::NTScalar{TypeCode::Int32}.create());
+    initial["value"] = 42;
+
+    auto mbox(server::SharedPV::buildReadonly());
+    mbox.open(initial);
+
+    // indexed through onList()
+    auto counter(std::make_shared<SearchCounter>(true));
+    counter->serve("counted", mbox);
+
+    auto conf(server::Config::isolated());
+    conf.claim_index = true;
+    auto serv = conf.build()
+            .addPV("mailbox", mbox)
+            .addSource("count", counter)
+            .addSource("err", std::make_shared<ErrorSource>(false))
+            .start();
+
+    auto cli = serv.clientConfig().build();
+
+    auto doGet = [&cli](const char* name) -> client::Result {
+        client::Result actual;
+        epicsEvent done;
+
+        auto op = cli.get(name)
+                .result([&actual, &done](client::Result&& result) {
+                    actual = std::move(result);
+                    done.signal();
+                })
+                .exec();
+
+        cli.hurryUp();
+
+        if(!done.wait(5.0))
+            testFail("timeout %s", name);
+        return actual;
+    };
+
+    // from the index
+    testEq(doGet("mailbox")()["value"].as<int32_t>(), 42);
+
+    // index rebuilt after adding
+    serv.addPV("later", mbox);
+    testEq(doGet("later")()["value"].as<int32_t>(), 42);
+
+    // not in the index, so found by ErrorSource
+    auto actual(doGet("other"));
+    testThrows<client::RemoteError>([&actual]() {
+        auto val = actual();
+        testShow()<<"unexpected result\n"<<val;
+    });
+
+    testEq(doGet("counted")()["value"].as<int32_t>(), 42);
+    // indexed Sources are not asked
+    testEq(counter->requests(), 0u);
+}
+
+// StaticSource re-uses its list until add() or remove()
+void testStaticList()
+{
+    testShow()<<__func__;
+
+    auto mbox(server::SharedPV::buildReadonly());
+    auto src(server::StaticSource::build());
+    src.add("one", mbox);
+
+    auto L1(src.source()->onList());
+    auto L2(src.source()->onList());
+    testOk(L1.version!=0u && L1.version==L2.version, "version %llu %llu",
+           (unsigned long long)L1.version, (unsigned long long)L2.version);
+    // not rebuilt while referenced
+    testOk1(L1.names==L2.names);
+
+    src.add("two", mbox);
+    auto L3(src.source()->onList());
+    testOk1(L3.version!=L2.version);
+    testEq(L3.names->size(), 2u);
+
+    src.remove("one");
+    auto L4(src.source()->onList());
+    testOk1(L4.version!=L3.version);
+}
+
+// number of Values allocated so far
+size_t nallocated()
+{
+    auto snap(instanceSnapshot());
+    return snap["StructTopPoolHit"] + snap["StructTopPoolMiss"];
+}
+
+// SharedPV::post() copies the current value only after a reply may reference it
+void testPostCopy()
+{
+    testShow()<<__func__;
+
+    auto initial(nt::NTScalar{TypeCode::Int32}.create());
+    initial["value"] = 42;
+
+    auto mbox(server::SharedPV::buildReadonly());
+    mbox.open(initial);
+
+    auto serv = server::Config::isolated()
+            .build()
+            .addPV("mailbox", mbox)
+            .start();
+
+    auto cli = serv.clientConfig().build();
+
+    auto update(initial.cloneEmpty());
+    size_t before;
+
+    // no reader since open(), so no copy
+    update["value"] = 43;
+    before = nallocated();
+    mbox.post(update);
+    testEq(nallocated() - before, 0u);
+
+    auto prev(cli.get("mailbox").exec()->wait(5.0));
+    testEq(prev["value"].as<int32_t>(), 43);
+
+    // first post() after GET copies once
+    update["value"] = 44;
+    before = nallocated();
+    mbox.post(update);
+    testEq(nallocated() - before, 1u);
+
+    // no reader in between
+    update["value"] = 45;
+    before = nallocated();
+    mbox.post(update);
+    testEq(nallocated() - before, 0u);
+
+    // earlier result not changed
+    testEq(prev["value"].as<int32_t>(), 43);
+    testEq(cli.get("mailbox").exec()->wait(5.0)["value"].as<int32_t>(), 45);
+}
+
+// repeated search misses answered from Config::search_miss_cache
+void testMissCache()
+{
+    testShow()<<__func__;
+
+    auto initial(nt::NTScalar{TypeCode::Int32}.create());
+    initial["value"] = 42;
+
+    auto mbox(server::SharedPV::buildReadonly());
+    mbox.open(initial);
+
+    // asked only on a miss
+    auto counter(std::make_shared<SearchCounter>());
+
+    auto conf(server::Config::isolated());
+    conf.search_miss_cache = 16u;
+    auto serv = conf.build()
+            .addPV("mailbox", mbox)
+            .addSource("count", counter)
+            .start();
+
+    auto cli = serv.clientConfig().build();
+
+    client::Result actual;
+    epicsEvent done;
+
+    auto op = cli.get("late")
+            .result([&actual, &done](client::Result&& result) {
+                actual = std::move(result);
+                done.signal();
+            })
+            .exec();
+
+    // repeated searches, which no Source claims
+    for(auto i : range(5)) {
+        (void)i;
+        cli.hurryUp();
+        epicsThreadSleep(0.2);
+    }
+    testOk1(!done.tryWait());
+    // only the first search reaches the Sources
+    testEq(counter->times("late").size(), 1u);
+
+    // adding a PV changes the list of "__builtin", which clears the cache
+    serv.addPV("late", mbox);
+    cli.hurryUp();
+
+    if(testOk1(done.wait(5.0))) {
+        testEq(actual()["value"].as<int32_t>(), 42);
+    } else {
+        testSkip(1, "timeout");
+    }
+
+    // statistics from the "server" PV, which is not advertised
+    try {
+        auto info(cli.rpc("server")
+                  .server("127.0.0.1")
+                  .arg("op", "info")
+                  .exec()
+                  ->wait(5.0));
+        testDiag("cache hit %llu miss %llu size %llu",
+                 (unsigned long long)info["searchMissCache.hit"].as<uint64_t>(),
+                 (unsigned long long)info["searchMissCache.miss"].as<uint64_t>(),
+                 (unsigned long long)info["searchMissCache.size"].as<uint64_t>());
+        testOk1(info["searchMissCache.hit"].as<uint64_t>()>0u);
+        testOk1(info["searchMissCache.miss"].as<uint64_t>()>0u);
+        // received searches, and replied once "late" was added
+        testOk(info["searchUDP.rxPackets"].as<uint64_t>()>0u
+               && info["searchUDP.txPackets"].as<uint64_t>()>0u,
+               "server UDP rx %llu/%llu tx %llu/%llu",
+               (unsigned long long)info["searchUDP.rxPackets"].as<uint64_t>(),
+               (unsigned long long)info["searchUDP.rxSyscalls"].as<uint64_t>(),
+               (unsigned long long)info["searchUDP.txPackets"].as<uint64_t>(),
+               (unsigned long long)info["searchUDP.txSyscalls"].as<uint64_t>());
+    }catch(std::exception& e){
+        testFail("server info: %s", e.what());
+        testSkip(2, "No info");
+    }
+
+    auto stats(cli.searchStats());
+    testOk(stats.txPackets>0u && stats.txSyscalls>0u && stats.txSyscalls<=stats.txPackets,
+           "client search tx %llu packets in %llu syscalls",
+           (unsigned long long)stats.txPackets, (unsigned long long)stats.txSyscalls);
+    testOk(stats.rxPackets>0u && stats.rxSyscalls>0u,
+           "client search rx %llu packets in %llu syscalls",
+           (unsigned long long)stats.rxPackets, (unsigned long long)stats.rxSyscalls);
+}
+
+// more Channels than fit in one search packet, with Config::search_max_rate
+void testSearchRate()
+{
+    testShow()<<__func__;
+
+    auto initial(nt::NTScalar{TypeCode::Int32}.create());
+    auto builder(server::Config::isolated().build());
+
+    const size_t npv = 200u;
+    for(auto i : range(npv)) {
+        auto pv(server::SharedPV::buildReadonly());
+        auto val(initial.cloneEmpty());
+        val["value"] = int32_t(i);
+        pv.open(val);
+        builder.addPV(SB()<<"rate:limited:pv:name:"<<i, pv);
+    }
+
+    auto src(std::make_shared<SearchCounter>());
+    builder.addSource("count", src);
+
+    auto serv(builder.start());
+
+    auto cliconf(serv.clientConfig());
+    cliconf.search_max_rate = 2.0;
+    auto cli(cliconf.build());
+    testEq(cli.config().search_max_rate, 2.0);
+
+    std::atomic<size_t> nok{0u};
+    epicsEvent done;
+
+    std::vector<std::shared_ptr<client::Operation>> ops;
+    for(auto i : range(npv)) {
+        ops.push_back(cli.get(SB()<<"rate:limited:pv:name:"<<i)
+                      .result([&nok, &done, npv](client::Result&& result) {
+                          try {
+                              (void)result();
+                          }catch(std::exception& e){
+                              testDiag("Error %s", e.what());
+                              return;
+                          }
+                          if(++nok==npv)
+                              done.signal();
+                      })
+                      .exec());
+    }
+
+    cli.hurryUp();
+
+    // the first tick has credit for search_max_rate datagrams.  More are needed.
+    for(unsigned i=0u; i<50u && !src->requests(); i++)
+        epicsThreadSleep(0.1);
+    epicsThreadSleep(0.3);
+    auto nfirst(src->requests());
+    testOk(nfirst>0u && nfirst<=3u, "%zu search requests in first tick", nfirst);
+
+    testOk(done.wait(10.0), "%zu of %zu complete", nok.load(), npv);
+}
+
+// pop until event E, discarding updates and other events
+template<typename E>
+bool waitEvent(client::Subscription& sub, epicsEvent& evt, double timeout)
+{
+    const epicsTime deadline(epicsTime::getCurrent() + timeout);
+    while(true) {
+        try {
+            if(!sub.pop()) {
+                double remaining = deadline - epicsTime::getCurrent();
+                if(remaining<=0.0 || !evt.wait(remaining))
+                    return false;
+            }
+        }catch(E&){
+            return true;
+        }catch(std::exception& e){
+            testDiag("ignore %s", e.what());
+        }
+    }
+}
+
+// repeated searches for a missing PV back off exponentially
+void testBackoff()
+{
+    testShow()<<__func__;
+
+    auto src(std::make_shared<SearchCounter>());
+    auto serv(server::Config::isolated()
+              .build()
+              .addSource("count", src)
+              .start());
+
+    auto cli(serv.clientConfig().build());
+
+    auto sub(cli.monitor("backoff:missing").exec());
+    cli.hurryUp();
+
+    // searched after 0, 1, 3, 7 ticks
+    epicsThreadSleep(8.5);
+
+    auto times(src->times("backoff:missing"));
+    if(testOk(times.size()>=4u, "searched %zu times", times.size())) {
+        for(auto i : range(1u, 4u)) {
+            double gap = times[i] - times[i-1u];
+            testOk(std::fabs(gap - double(1u<<(i-1u))) < 0.5, "gap %u %.2f sec", unsigned(i), gap);
+        }
+    } else {
+        testSkip(3, "Too few searches");
+    }
+}
+
+// a server restarted with the same TCP port.  Only its Channels are re-searched.
+void testRestart()
+{
+    testShow()<<__func__;
+
+    auto initial(nt::NTScalar{TypeCode::Int32}.create());
+    auto pv(server::SharedPV::buildReadonly());
+    pv.open(initial);
+
+    auto src(std::make_shared<SearchCounter>());
+    src->serve("restart:pv", pv);
+
+    auto serv(server::Config::isolated()
+              .build()
+              .addSource("count", src)
+              .start());
+    // restart with the same ports
+    auto conf(serv.config());
+
+    auto cli(serv.clientConfig().build());
+
+    epicsEvent evt;
+    auto sub(cli.monitor("restart:pv")
+             .maskConnected(false)
+             .maskDisconnected(false)
+             .event([&evt](client::Subscription&) {
+                 evt.signal();
+             })
+             .exec());
+    // never found
+    auto missing(cli.monitor("restart:missing").exec());
+
+    cli.hurryUp();
+
+    testOk1(waitEvent<client::Connected>(*sub, evt, 5.0));
+
+    serv.stop();
+    serv = server::Server();
+
+    testOk1(waitEvent<client::Disconnect>(*sub, evt, 5.0));
+
+    // let backoff of both Channels grow longer than the following wait
+    epicsThreadSleep(9.0);
+    const auto nmissing(src->times("restart:missing").size());
+
+    serv = conf.build()
+            .addSource("count", src)
+            .start();
+    testEq(serv.config().tcp_port, conf.tcp_port);
+
+    // first beacon from the restarted server has a new GUID
+    testOk1(waitEvent<client::Connected>(*sub, evt, 3.0));
+    // not poked
+    testEq(src->times("restart:missing").size(), nmissing);
+}
+
+// CommonBuilder::server() connects without searching
+void testDirect()
+{
+    testShow()<<__func__;
+
+    auto initial(nt::NTScalar{TypeCode::Int32}.create());
+    initial["value"] = 42;
+
+    auto mbox(server::SharedPV::buildReadonly());
+    mbox.open(initial);
+
+    auto src(std::make_shared<SearchCounter>());
+    src->serve("direct", mbox);
+
+    auto serv(server::Config::isolated()
+              .build()
+              .addSource("count", src)
+              .start());
+
+    // Server::clientConfig() includes the server tcp_port
+    auto cli(serv.clientConfig().build());
+    testEq(cli.config().tcp_port, serv.config().tcp_port);
+
+    auto val(cli.get("direct")
+             .server(SB()<<"127.0.0.1:"<<serv.config().tcp_port)
+             .exec()
+             ->wait(5.0));
+    testEq(val["value"].as<int32_t>(), 42);
+
+    // default port
+    val = cli.get("direct")
+            .server("127.0.0.1")
+            .exec()
+            ->wait(5.0);
+    testEq(val["value"].as<int32_t>(), 42);
+
+    testEq(src->times("direct").size(), 0u);
+
+    testThrows<std::runtime_error>([&cli]() {
+        cli.get("direct")
+                .server("not an address")
+                .exec();
+    });
+}
+
 } // namespace
 
 MAIN(testget)
 {
-    testPlan(15);
+    testPlan(69);
     testSetup();
     logger_config_env();
     Tester().testWaiter();
@@ -267,6 +872,16 @@ MAIN(testget)
     Tester().orphan();
     testError(false);
     testError(true);
+    testWorkers();
+    testClientWorkers();
+    testClaimIndex();
+    testStaticList();
+    testPostCopy();
+    testMissCache();
+    testSearchRate();
+    testBackoff();
+    testRestart();
+    testDirect();
     cleanup_for_valgrind();
     return testDone();
 }
@@ -5,12 +5,14 @@
  */
 
 #include <atomic>
+#include <map>
 
 #include <testMain.h>
 
 #include <epicsUnitTest.h>
 
 #include <epicsEvent.h>
+#include <epicsMutex.h>
 
 #include <pvxs/unittest.h>
 #include <pvxs/log.h>
@@ -257,11 +259,308 @@ struct TestReconn : public BasicTest
     }
 };
 
+// several subscriptions to one SharedPV, some with the same pvRequest
+struct TestFanout : public BasicTest
+{
+    void testFanout()
+    {
+        testShow()<<__func__;
+
+        serv.start();
+        mbox.open(initial);
+
+        epicsEvent evt2, evt3;
+        subscribe("mailbox");
+        auto sub2 = cli.monitor("mailbox")
+                        .maskConnected(true)
+                        .maskDisconnected(false)
+                        .event([&evt2](client::Subscription& sub) {
+                            evt2.signal();
+                        })
+                        .exec();
+        auto sub3 = cli.monitor("mailbox")
+                        .field("value")
+                        .maskConnected(true)
+                        .maskDisconnected(false)
+                        .event([&evt3](client::Subscription& sub) {
+                            evt3.signal();
+                        })
+                        .exec();
+
+        cli.hurryUp();
+
+        testThrows<client::Connected>([this](){
+            pop(sub, evt);
+        });
+
+        for(auto s : {std::make_pair(sub, &evt), std::make_pair(sub2, &evt2), std::make_pair(sub3, &evt3)}) {
+            if(auto val = pop(s.first, *s.second)) {
+                testEq(val["value"].as<int32_t>(), 42);
+            } else {
+                testFail("Missing data update");
+            }
+        }
+
+        auto update(initial.cloneEmpty());
+        update["value"] = 5;
+        update["alarm.severity"] = 1;
+        mbox.post(update);
+
+        for(auto s : {std::make_pair(sub, &evt), std::make_pair(sub2, &evt2)}) {
+            if(auto val = pop(s.first, *s.second)) {
+                testEq(val["value"].as<int32_t>(), 5);
+                testEq(val["alarm.severity"].as<int32_t>(), 1);
+            } else {
+                testFail("Missing data update");
+            }
+        }
+
+        if(auto val = pop(sub3, evt3)) {
+            testEq(val["value"].as<int32_t>(), 5);
+            testFalse(val["alarm.severity"].isMarked());
+        } else {
+            testFail("Missing data update");
+        }
+    }
+};
+
+// posts squashed while the subscription is not yet started
+struct SquashSource : public server::Source
+{
+    const Value type;
+    std::unique_ptr<server::MonitorControlOp> ctrl;
+    server::MonitorStat stat{};
+
+    SquashSource()
+        :type(nt::NTScalar{TypeCode::Int32}.create())
+    {}
+
+    virtual void onSearch(Search &op) override final
+    {
+        for(auto& name : op) {
+            name.claim();
+        }
+    }
+    virtual void onCreate(std::unique_ptr<server::ChannelControl> &&op) override final
+    {
+        auto chan = std::move(op);
+
+        chan->onSubscribe([this](std::unique_ptr<server::MonitorSetupOp>&& setup) {
+            // runs on the server worker, so START is not processed until we return.
+            ctrl = setup->connect(type);
+
+            auto update(type.cloneEmpty());
+            update["value"] = 1;
+            ctrl->post(update);
+
+            update = type.cloneEmpty();
+            update["value"] = 2;
+            ctrl->post(update); // squash
+
+            update = type.cloneEmpty();
+            update["alarm.severity"] = 1;
+            ctrl->post(update); // squash
+
+            ctrl->stats(stat);
+        });
+    }
+};
+
+void testOverrun()
+{
+    testShow()<<__func__;
+
+    auto src(std::make_shared<SquashSource>());
+    auto serv = server::Config::isolated()
+            .build()
+            .addSource("squash", src)
+            .start();
+
+    auto cli = serv.clientConfig().build();
+
+    epicsEvent evt;
+    auto sub = cli.monitor("squash")
+            .event([&evt](client::Subscription& sub) {
+                evt.signal();
+            })
+            .exec();
+
+    cli.hurryUp();
+
+    Value val, overrun;
+    while(!(val = sub->pop(overrun))) {
+        if(!evt.wait(5.0)) {
+            testFail("timeout waiting for event");
+            break;
+        }
+    }
+
+    if(val && overrun) {
+        testEq(val["value"].as<int32_t>(), 2);
+        testEq(val["alarm.severity"].as<int32_t>(), 1);
+        testOk1(overrun["value"].isMarked());
+        testOk1(!overrun["alarm.severity"].isMarked());
+    } else {
+        testSkip(4, "Missing data update");
+    }
+
+    testEq(src->stat.nSquash, 2u);
+    testEq(src->stat.nQueue, 1u);
+}
+
+// one Value posted to two subscriptions, so its serialization is cached
+struct SharedSource : public server::Source
+{
+    const Value type;
+    epicsMutex lock;
+    std::map<std::string, std::unique_ptr<server::MonitorControlOp>> ctrls;
+    size_t nstarted = 0u;
+    epicsEvent started;
+
+    SharedSource()
+        :type(nt::NTScalar{TypeCode::Int32}.create())
+    {}
+
+    virtual void onSearch(Search &op) override final
+    {
+        for(auto& name : op) {
+            name.claim();
+        }
+    }
+    virtual void onCreate(std::unique_ptr<server::ChannelControl> &&op) override final
+    {
+        auto chan = std::move(op);
+        std::string name(chan->name());
+
+        chan->onSubscribe([this, name](std::unique_ptr<server::MonitorSetupOp>&& setup) {
+            auto ctrl(setup->connect(type));
+            ctrl->onStart([this](bool start) {
+                if(start) {
+                    {
+                        epicsGuard<epicsMutex> G(lock);
+                        nstarted++;
+                    }
+                    started.signal();
+                }
+            });
+
+            epicsGuard<epicsMutex> G(lock);
+            ctrls[name] = std::move(ctrl);
+        });
+    }
+
+    bool waitStarted(size_t n)
+    {
+        while(true) {
+            {
+                epicsGuard<epicsMutex> G(lock);
+                if(nstarted>=n)
+                    return true;
+            }
+            if(!started.wait(5.0))
+                return false;
+        }
+    }
+};
+
+Value popWait(const std::shared_ptr<client::Subscription>& sub, epicsEvent& evt)
+{
+    for(unsigned i=0u; i<5u; i++) {
+        if(auto val = sub->pop())
+            return val;
+        evt.wait(1.0);
+    }
+    testDiag("timeout waiting for update");
+    return Value();
+}
+
+int32_t valueOf(const Value& val)
+{
+    return val ? val["value"].as<int32_t>() : -1;
+}
+
+// squash into a queued Value whose serialization was cached by another subscription
+void testSquashShared()
+{
+    testShow()<<__func__;
+
+    auto src(std::make_shared<SharedSource>());
+    auto serv = server::Config::isolated()
+            .build()
+            .addSource("shared", src)
+            .start();
+
+    auto cli = serv.clientConfig().build();
+
+    epicsEvent evtA, evtB;
+    auto subA = cli.monitor("a")
+            .event([&evtA](client::Subscription&) {
+                evtA.signal();
+            })
+            .exec();
+    // server queue of one, only refilled after the client pops
+    auto subB = cli.monitor("b")
+            .record("pipeline", true)
+            .record("queueSize", 1u)
+            .event([&evtB](client::Subscription&) {
+                evtB.signal();
+            })
+            .exec();
+
+    cli.hurryUp();
+
+    if(!testOk1(src->waitStarted(2u))) {
+        testSkip(6, "subscriptions not started");
+        return;
+    }
+
+    server::MonitorControlOp* ctrlA;
+    server::MonitorControlOp* ctrlB;
+    {
+        epicsGuard<epicsMutex> G(src->lock);
+        ctrlA = src->ctrls["a"].get();
+        ctrlB = src->ctrls["b"].get();
+    }
+
+    {
+        auto initial(src->type.cloneEmpty());
+        initial["value"] = 1;
+        ctrlA->post(initial);
+        ctrlB->post(initial);
+    }
+    testEq(valueOf(popWait(subA, evtA)), 1);
+    // B's first update reaches the client, which doesn't pop yet.  So B's window is empty.
+    testOk1(evtB.wait(5.0));
+
+    {
+        auto update(src->type.cloneEmpty());
+        update["value"] = 2;
+        ctrlA->post(update);
+        ctrlB->post(update);
+    }
+    // A has encoded, and dropped, the shared Value.  Now only queued for B.
+    testEq(valueOf(popWait(subA, evtA)), 2);
+
+    {
+        auto update(src->type.cloneEmpty());
+        update["value"] = 3;
+        ctrlB->post(update); // squash
+    }
+
+    server::MonitorStat stat{};
+    ctrlB->stats(stat);
+    testEq(stat.nSquash, 1u);
+
+    // pop sends ack, and the squashed update
+    testEq(valueOf(popWait(subB, evtB)), 1);
+    testEq(valueOf(popWait(subB, evtB)), 3);
+}
+
 } // namespace
 
 MAIN(testmon)
 {
-    testPlan(22);
+    testPlan(45);
     testSetup();
     logger_config_env();
     BasicTest().orphan();
@@ -269,6 +568,9 @@ MAIN(testmon)
     TestLifeCycle().testBasic(false);
     TestLifeCycle().testSecond();
     TestReconn().testReconn();
+    TestFanout().testFanout();
+    testOverrun();
+    testSquashShared();
     cleanup_for_valgrind();
     return testDone();
 }
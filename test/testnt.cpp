@@ -73,12 +73,66 @@ void testNTURI()
     testEq(top["query.arg2"].as<std::string>(), "hello");
 }
 
+void testNTTable()
+{
+    testDiag("In %s", __func__);
+
+    auto top = nt::NTTable{}
+            .addColumn(TypeCode::Int32A, "index", "Index")
+            .addColumn(TypeCode::Float64A, "position")
+            .create();
+
+    testTrue(top.idStartsWith("epics:nt/NTTable:"));
+    testEq(top["value.index"].type(), TypeCode::Int32A);
+    testEq(top["value.position"].type(), TypeCode::Float64A);
+    {
+        auto labels(top["labels"].as<shared_array<const std::string>>());
+        testEq(labels.size(), 2u);
+        testEq(labels.at(0), "Index");
+        testEq(labels.at(1), "position");
+    }
+
+    testThrows<std::logic_error>([]() {
+        nt::NTTable{}.addColumn(TypeCode::Int32, "scalar");
+    });
+
+    nt::NTTableColumns cols(top);
+    testEq(cols.size(), 2u);
+    testEq(cols.name(1), "position");
+    testEq(cols.index("position"), 1u);
+    testThrows<LookupError>([&cols]() {
+        cols.index("nonexistent");
+    });
+
+    shared_array<int32_t> index({1, 2, 3});
+    shared_array<double> position({1.5, 2.5, 3.5});
+    const shared_array<const int32_t> cindex(index.freeze());
+    const shared_array<const double> cposition(position.freeze());
+
+    auto update(top.cloneEmpty());
+    cols.set(update, 0u, cindex);
+    cols.set(update, 1u, cposition);
+    testTrue(update["value.index"].isMarked());
+    testEq(cols.rows(update), 3u);
+
+    // same element type is a reference, not a copy
+    testEq(cols.get<int32_t>(update, 0u).data(), cindex.data());
+    testEq(cols.get<double>(update, 1u).data(), cposition.data());
+    // other element type is converted
+    testArrEq(cols.get<double>(update, 0u), shared_array<const double>({1.0, 2.0, 3.0}));
+
+    testThrows<NoConvert>([&cols, &update, &cposition]() {
+        cols.set(update, 0u, cposition);
+    });
+}
+
 } // namespace
 
 MAIN(testnt) {
-    testPlan(17);
+    testPlan(34);
     testNTScalar();
     testNTNDArray();
     testNTURI();
+    testNTTable();
     return testDone();
 }
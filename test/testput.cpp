@@ -5,6 +5,7 @@
  */
 
 #include <atomic>
+#include <algorithm>
 
 #include <testMain.h>
 
@@ -329,11 +330,117 @@ void testError()
     }
 }
 
+void testSegmented()
+{
+    testShow()<<__func__;
+
+    auto mbox(server::SharedPV::buildMailbox());
+    auto initial = nt::NTScalar{TypeCode::Float64A}.create();
+    mbox.open(initial);
+
+    // much shorter than the array
+    auto servconf(server::Config::isolated());
+    servconf.tcp_segment_size = 1000u;
+    auto serv = servconf.build()
+            .addPV("mailbox", mbox)
+            .start();
+
+    auto cliconf(serv.clientConfig());
+    cliconf.tcp_segment_size = 1000u;
+    auto cli = cliconf.build();
+
+    shared_array<double> arr(10000u);
+    for(size_t i=0; i<arr.size(); i++)
+        arr[i] = double(i);
+    auto expect(arr.freeze());
+
+    auto put = cli.put("mailbox")
+            .set("value", expect)
+            .exec();
+    // queued behind the segmented PUT
+    auto get = cli.get("mailbox")
+            .exec();
+
+    cli.hurryUp();
+
+    put->wait(5.0);
+    testPass("PUT complete");
+
+    auto actual = get->wait(5.0)["value"].as<shared_array<const double>>();
+    testOk(actual.size()==expect.size() && std::equal(actual.begin(), actual.end(), expect.begin()),
+           "GET value matches PUT");
+}
+
+// replies to GET with a large array, then closes the channel.  The unsolicited
+// DESTROY_CHANNEL must not be sent between segments of the reply.
+struct CloseSource : public server::Source
+{
+    Value initial;
+    std::shared_ptr<server::ChannelControl> chan;
+
+    virtual void onSearch(Search &op) override final
+    {
+        for(auto& name : op) {
+            name.claim();
+        }
+    }
+    virtual void onCreate(std::unique_ptr<server::ChannelControl> &&op) override final
+    {
+        // only accessed from the server worker
+        chan = std::move(op);
+        std::weak_ptr<server::ChannelControl> wchan(chan);
+
+        chan->onOp([this, wchan](std::unique_ptr<server::ConnectOp>&& op) {
+            op->onGet([this, wchan](std::unique_ptr<server::ExecOp>&& op) {
+                op->reply(initial);
+                if(auto ch = wchan.lock())
+                    ch->close();
+            });
+            op->connect(initial);
+        });
+    }
+};
+
+void testSegmentedClose()
+{
+    testShow()<<__func__;
+
+    shared_array<double> arr(10000u);
+    for(size_t i=0; i<arr.size(); i++)
+        arr[i] = double(i);
+    auto expect(arr.freeze());
+
+    auto src(std::make_shared<CloseSource>());
+    src->initial = nt::NTScalar{TypeCode::Float64A}.create();
+    src->initial["value"] = expect;
+
+    auto servconf(server::Config::isolated());
+    servconf.tcp_segment_size = 1000u;
+    auto serv = servconf.build()
+            .addSource("close", src)
+            .start();
+
+    auto cli = serv.clientConfig().build();
+
+    auto get = cli.get("big")
+            .exec();
+
+    cli.hurryUp();
+
+    try {
+        auto actual = get->wait(5.0)["value"].as<shared_array<const double>>();
+        testOk(actual.size()==expect.size() && std::equal(actual.begin(), actual.end(), expect.begin()),
+               "GET value complete");
+    }catch(std::exception& e){
+        testFail("GET error %s : %s", typeid(e).name(), e.what());
+    }
+}
+
 } // namespace
 
 MAIN(testput)
 {
-    testPlan(26);
+    testPlan(29);
     testSetup();
     logger_config_env();
     Tester().loopback(false);
@@ -345,6 +452,8 @@ MAIN(testput)
     TestPutBuilder().testSet();
     testRO();
     testError();
+    testSegmented();
+    testSegmentedClose();
     cleanup_for_valgrind();
     return testDone();
 }
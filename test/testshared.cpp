@@ -233,6 +233,34 @@ void testElemAlloc()
     auto varr = allocArray(ArrayType::UInt32, 3u);
     testEq(varr.size(), 3u);
     testEq(varr.original_type(), ArrayType::UInt32);
+    testEq(size_t(varr.data())%detail::sa_alignment, 0u);
+
+    auto sarr = allocArray(ArrayType::String, 2u);
+    testEq(sarr.size(), 2u);
+    testEq(sarr.castTo<std::string>()[1], "");
+}
+
+void testUninitialized()
+{
+    testDiag("%s", __func__);
+
+    testOk1(allocUninitialized<double>(0u).empty());
+
+    for(size_t count : {1u, 3u, 1000u}) {
+        auto arr(allocUninitialized<uint16_t>(count));
+        testEq(arr.size(), count);
+        testEq(size_t(arr.data())%detail::sa_alignment, 0u);
+        testOk1(arr.unique());
+
+        for(size_t i=0u; i<count; i++)
+            arr[i] = uint16_t(i);
+
+        auto carr(arr.freeze());
+        testEq(carr[count-1u], uint16_t(count-1u));
+        // still usable through a void reference
+        auto varr(carr.castTo<const void>());
+        testEq(varr.original_type(), ArrayType::UInt16);
+    }
 }
 
 void testConvert()
@@ -267,7 +295,7 @@ void testConvert()
 
 MAIN(testshared)
 {
-    testPlan(115);
+    testPlan(134);
     testSetup();
     testEmpty<void>();
     testEmpty<const void>();
@@ -284,6 +312,7 @@ MAIN(testshared)
     testCast();
     testFromVector();
     testElemAlloc();
+    testUninitialized();
     testConvert();
     return testDone();
 }
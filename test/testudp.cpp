@@ -17,6 +17,7 @@
 
 #include <pvxs/log.h>
 #include "evhelper.h"
+#include "utilpvt.h"
 #include <udp_collector.h>
 
 namespace {
@@ -146,12 +147,96 @@ void testSearch(bool be, std::initializer_list<const char*> names)
     testOk1(!!rx.wait(30.0));
 }
 
+void testRxBatch()
+{
+    testDiag("In %s", __func__);
+
+    SockAddr rxaddr(SockAddr::loopback(AF_INET));
+    SockAddr txaddr(SockAddr::loopback(AF_INET));
+
+    evsocket rxsock(AF_INET, SOCK_DGRAM, 0);
+    rxsock.bind(rxaddr);
+    evsocket txsock(AF_INET, SOCK_DGRAM, 0);
+    txsock.bind(txaddr);
+
+    UDPRxBatch batch(4u);
+    testEq(batch.capacity(), 4u);
+
+    testOk1(batch.receive(rxsock.sock)<0);
+
+    for(uint8_t i : {1u, 2u, 3u}) {
+        uint8_t msg[3] = {i, i, i};
+        testOk1(sendto(txsock.sock, (char*)msg, i, 0, &rxaddr->sa, rxaddr.size())==int(i));
+    }
+
+    // loopback delivery is immediate
+    auto n = batch.receive(rxsock.sock);
+    if(testEq(n, 3)) {
+        for(auto i : range(3u)) {
+            testEq(batch[i].len, i+1u);
+            testEq(unsigned(batch[i].buf[0]), i+1u);
+            testEq(batch[i].src, txaddr);
+        }
+    }
+    testEq(batch.npacket, 3u);
+    testDiag("syscalls %zu", batch.nsyscall);
+
+#ifdef __linux__
+    // only the last buffer has room for a large datagram
+    std::vector<uint8_t> big(0x8000, 0x42);
+    for(auto i : range(batch.capacity())) {
+        (void)i;
+        testOk1(sendto(txsock.sock, (char*)big.data(), big.size(), 0, &rxaddr->sa, rxaddr.size())==int(big.size()));
+    }
+
+    n = batch.receive(rxsock.sock);
+    if(testEq(n, 4)) {
+        testEq(batch[0].len, size_t(UDPRxBatch::slotSize-1u));
+        testEq(batch[3].len, big.size());
+    } else {
+        testSkip(2, "short batch");
+    }
+    testEq(batch.ntrunc, 3u);
+#else
+    testSkip(8, "truncation only detected with recvmmsg()");
+#endif
+}
+
+void testTxBatch()
+{
+    testDiag("In %s", __func__);
+
+    SockAddr rxaddr(SockAddr::loopback(AF_INET));
+    SockAddr txaddr(SockAddr::loopback(AF_INET));
+
+    evsocket rxsock(AF_INET, SOCK_DGRAM, 0);
+    rxsock.bind(rxaddr);
+    evsocket txsock(AF_INET, SOCK_DGRAM, 0);
+    txsock.bind(txaddr);
+
+    UDPTxBatch tx;
+    for(uint8_t i : {1u, 2u, 3u}) {
+        uint8_t msg[3] = {i, i, i};
+        tx.push(msg, i, rxaddr);
+    }
+
+    testEq(tx.flush(txsock.sock), 3u);
+    for(auto i : range(3u)) {
+        testEq(tx[i].ntx, int(i+1u));
+    }
+    testEq(tx.npacket, 3u);
+    testDiag("syscalls %zu", tx.nsyscall);
+
+    UDPRxBatch rx(4u);
+    testEq(rx.receive(rxsock.sock), 3);
+}
+
 } // namespace
 
 int main(int argc, char *argv[])
 {
     SockAttach attach;
-    testPlan(46);
+    testPlan(76);
     testSetup();
     pvxs::logger_config_env();
     testBeacon(true);
@@ -160,6 +245,8 @@ int main(int argc, char *argv[])
     testSearch(false, {"hello"});
     testSearch(true , {"one", "two"});
     testSearch(false, {"one", "two"});
+    testRxBatch();
+    testTxBatch();
     cleanup_for_valgrind();
     return testDone();
 }
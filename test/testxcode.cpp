@@ -4,6 +4,9 @@
  * in file LICENSE that is included with this distribution.
  */
 
+#include <algorithm>
+#include <functional>
+
 #include <epicsUnitTest.h>
 #include <testMain.h>
 
@@ -11,6 +14,7 @@
 #include <pvxs/unittest.h>
 #include <pvxs/nt.h>
 #include "dataimpl.h"
+#include "evhelper.h"
 #include "pvaproto.h"
 
 namespace {
@@ -583,6 +587,198 @@ void testArrayXCode()
     testArrayXCodeT<std::string>("\x01\x02\x02\x05hello\x05world", {"hello", "world"});
 }
 
+// round trip an array large enough to span several buffer segments
+template<typename E>
+void testArrayXCodeBulk(bool be)
+{
+    testShow()<<__func__<<"<"<<detail::CaptureBase<E>::code<<">("<<(be ? "BE" : "LE")<<")";
+
+    shared_array<E> input(100000u);
+    for(auto i : range(input.size()))
+        input[i] = E(i*3u);
+    auto expected(input.freeze());
+
+    auto code = TypeCode(ScalarMap<E>::code).arrayOf();
+    TypeDef def(TypeCode::Struct, {Member(code, "value")});
+    auto val = def.create();
+    val["value"] = expected;
+
+    evbuf encoded(evbuffer_new());
+    {
+        EvOutBuf M(be, encoded.get());
+        to_wire_valid(M, val);
+        testOk1(M.good());
+    }
+    // BitMask + Size + elements
+    const size_t hlen = 2u + 5u;
+    testEq(evbuffer_get_length(encoded.get()), hlen + expected.size()*sizeof(E));
+
+    std::vector<uint8_t> flat(evbuffer_get_length(encoded.get()));
+    evbuffer_remove(encoded.get(), flat.data(), flat.size());
+
+    {
+        std::vector<uint8_t> elem;
+        VectorOutBuf S(be, elem);
+        to_wire(S, expected[1]);
+        elem.resize(S.consumed());
+        testOk(std::equal(elem.begin(), elem.end(), flat.begin()+hlen+sizeof(E)), "byte order of [1]");
+    }
+
+    // re-assemble as many small segments, which do not end on element boundaries
+    evbuf segmented(evbuffer_new());
+    for(size_t pos=0u; pos<flat.size(); pos+=1001u) {
+        evbuffer_add_reference(segmented.get(), flat.data()+pos, std::min(size_t(1001u), flat.size()-pos),
+                               nullptr, nullptr);
+    }
+
+    TypeStore ctxt;
+    auto val2 = def.create();
+    {
+        EvInBuf M(be, segmented.get());
+        from_wire_valid(M, ctxt, val2);
+        testOk1(M.good());
+    }
+    testEq(evbuffer_get_length(segmented.get()), 0u);
+    testArrEq(expected, val2["value"].as<shared_array<const E>>());
+}
+
+void testArrayXCodeBulk()
+{
+    testDiag("%s", __func__);
+
+    for(auto be : {true, false}) {
+        testArrayXCodeBulk<int8_t>(be);
+        testArrayXCodeBulk<uint16_t>(be);
+        testArrayXCodeBulk<double>(be);
+    }
+}
+
+// decoding a large array, contiguous in the receive buffer, in host byte order,
+// references the receive buffer in place.
+template<typename E>
+void testArrayAdopt(bool be, size_t nelem, size_t pad)
+{
+    testShow()<<__func__<<"<"<<detail::CaptureBase<E>::code<<">("<<(be ? "BE" : "LE")<<", "<<nelem<<", "<<pad<<")";
+
+    shared_array<E> input(nelem);
+    for(auto i : range(input.size()))
+        input[i] = E(i);
+    auto expected(input.freeze());
+
+    auto code = TypeCode(ScalarMap<E>::code).arrayOf();
+    TypeDef def(TypeCode::Struct, {Member(code, "value")});
+
+    std::vector<uint8_t> flat(pad);
+    {
+        auto val = def.create();
+        val["value"] = expected;
+        VectorOutBuf S(be, flat);
+        S._skip(pad);
+        to_wire_valid(S, val);
+        flat.resize(S.consumed());
+    }
+
+    evbuf encoded(evbuffer_new());
+    evbuffer_add(encoded.get(), flat.data(), flat.size());
+    // BitMask + Size
+    auto first = evbuffer_pullup(encoded.get(), -1) + pad + 2u + (nelem<254u ? 1u : 5u);
+
+    const bool expect = (be==hostBE || sizeof(E)==1u)
+            && nelem*sizeof(E) >= 0x10000u
+            && reinterpret_cast<size_t>(first)%alignof(E)==0u;
+
+    TypeStore ctxt;
+    auto val2 = def.create();
+    {
+        EvInBuf M(be, encoded.get());
+        M.skip(pad, __FILE__, __LINE__);
+        from_wire_valid(M, ctxt, val2);
+        testOk1(M.good());
+    }
+    auto actual(val2["value"].as<shared_array<const E>>());
+    testEq(actual.data()==reinterpret_cast<const E*>(first), expect);
+
+    // must remain valid
+    encoded.reset();
+    testArrEq(expected, actual);
+}
+
+void testArrayAdopt()
+{
+    testDiag("%s", __func__);
+
+    for(auto be : {true, false}) {
+        testArrayAdopt<uint8_t>(be, 0x10000u, 0u);
+        testArrayAdopt<double>(be, 0x10000u, 1u);
+    }
+    testArrayAdopt<uint8_t>(hostBE, 16u, 0u);
+}
+
+// encoding a large array, in host byte order, appends a reference to the array
+template<typename E>
+void testArrayReference(bool be, size_t nelem)
+{
+    testShow()<<__func__<<"<"<<detail::CaptureBase<E>::code<<">("<<(be ? "BE" : "LE")<<", "<<nelem<<")";
+
+    shared_array<E> input(nelem);
+    for(auto i : range(input.size()))
+        input[i] = E(i);
+    auto expected(input.freeze());
+
+    const bool expect = (be==hostBE || sizeof(E)==1u) && nelem*sizeof(E) >= 0x10000u;
+
+    auto code = TypeCode(ScalarMap<E>::code).arrayOf();
+    TypeDef def(TypeCode::Struct, {Member(code, "value")});
+
+    evbuf encoded(evbuffer_new());
+    {
+        auto val = def.create();
+        val["value"] = expected;
+        EvOutBuf S(be, encoded.get());
+        to_wire_valid(S, val);
+        testOk1(S.good());
+    }
+
+    bool found = false;
+    {
+        auto nvec = evbuffer_peek(encoded.get(), -1, nullptr, nullptr, 0);
+        std::vector<evbuffer_iovec> vecs(nvec);
+        evbuffer_peek(encoded.get(), -1, nullptr, vecs.data(), nvec);
+        for(auto& vec : vecs) {
+            if(vec.iov_base==expected.data() && vec.iov_len==nelem*sizeof(E))
+                found = true;
+        }
+    }
+    testEq(found, expect);
+    testEq(expected.dataPtr().use_count(), expect ? 2 : 1);
+
+    {
+        TypeStore ctxt;
+        auto val2 = def.create();
+        {
+            EvInBuf M(be, encoded.get());
+            from_wire_valid(M, ctxt, val2);
+            testOk1(M.good());
+        }
+        testArrEq(expected, val2["value"].as<shared_array<const E>>());
+    }
+
+    // decoded copy may also reference the array
+    encoded.reset();
+    testEq(expected.dataPtr().use_count(), 1);
+}
+
+void testArrayReference()
+{
+    testDiag("%s", __func__);
+
+    for(auto be : {true, false}) {
+        testArrayReference<uint8_t>(be, 0x10000u);
+        testArrayReference<double>(be, 0x10000u);
+    }
+    testArrayReference<uint8_t>(hostBE, 16u);
+}
+
 /*  epics:nt/NTScalarArray:1.0
  *      double[] value
  *      alarm_t alarm
@@ -977,11 +1173,182 @@ void testEmptyRequest()
            "[0] struct  parent=[0]  [0:1)\n")<<"\nActual descs2\n"<<descs2.data();
 }
 
+// identical types decoded separately share one FieldDesc tree
+void testIntern()
+{
+    testDiag("%s", __func__);
+
+    std::vector<uint8_t> msg(NTScalar, NTScalar+sizeof(NTScalar)-1);
+
+    Value val[2];
+    for(auto i : range(2u)) {
+        TypeStore cache; // as if from different connections
+        FixedBuf buf(true, msg);
+        from_wire_type(buf, cache, val[i]);
+        testOk1(buf.good() && buf.empty());
+    }
+
+    testOk1(Value::Helper::desc(val[0])==Value::Helper::desc(val[1]));
+    testOk1(val[0].equalType(val[1]));
+    testOk1(!val[0].equalInst(val[1]));
+
+    // same structure, different ID
+    auto other(msg);
+    auto pos = std::search(other.begin(), other.end(), "NTScalarArray", "NTScalarArray"+13);
+    if(testOk1(pos!=other.end())) {
+        pos[13-1] = 'X';
+        TypeStore cache;
+        Value val2;
+        FixedBuf buf(true, other);
+        from_wire_type(buf, cache, val2);
+        testOk1(buf.good() && buf.empty());
+        testOk1(Value::Helper::desc(val[0])!=Value::Helper::desc(val2));
+        testEq(val2.id(), "epics:nt/NTScalarArraX:1.0");
+    }
+}
+
+// DecodePlan decodes as from_wire_valid() does, for repeated and changing masks
+void testDecodePlan()
+{
+    testDiag("%s", __func__);
+
+    using namespace pvxs::members;
+
+    auto proto = TypeDef(TypeCode::Struct, {
+                             UInt8("u8"),
+                             Int16("i16"),
+                             Float32A("farr"),
+                             Struct("sub", {
+                                 String("str"),
+                                 Bool("flag"),
+                                 Struct("inner", {
+                                     UInt64("u64"),
+                                 }),
+                             }),
+                             Union("choice", {
+                                 Int32("ival"),
+                                 String("sval"),
+                             }),
+                         }).create();
+
+    auto src(proto.cloneEmpty());
+    src["u8"] = 255u;
+    src["i16"] = -2;
+    src["farr"] = shared_array<const float>({1.5f, 2.5f});
+    src["sub.str"] = "hello";
+    src["sub.flag"] = true;
+    src["sub.inner.u64"] = uint64_t(0xfedcba9876543210ull);
+    src["choice->sval"] = "world";
+
+    DecodePlan plan;
+    plan.reset(proto);
+
+    auto xcode = [&proto, &plan](const Value& val, const BitMask* mask) {
+        std::vector<uint8_t> buf;
+        {
+            VectorOutBuf S(true, buf);
+            to_wire_valid(S, val, mask);
+            buf.resize(buf.size()-S.size());
+        }
+
+        TypeStore ctxt;
+        Value expect(proto.cloneEmpty()), actual(proto.cloneEmpty());
+        {
+            FixedBuf S(true, buf);
+            from_wire_valid(S, ctxt, expect);
+            testOk1(S.good() && S.empty());
+        }
+        {
+            FixedBuf S(true, buf);
+            from_wire_valid(S, ctxt, actual, plan);
+            testOk1(S.good() && S.empty());
+        }
+        testEq(std::string(SB()<<actual.format().delta()), std::string(SB()<<expect.format().delta()));
+        return actual;
+    };
+
+    auto val(xcode(src, nullptr));
+    testEq(val["u8"].as<uint64_t>(), 255u);
+    testEq(val["sub.inner.u64"].as<uint64_t>(), uint64_t(0xfedcba9876543210ull));
+    testEq(val["choice->sval"].as<std::string>(), "world");
+    testOk1(val["sub"].isMarked(false, false));
+
+    // same mask again, from the cached field list
+    (void)xcode(src, nullptr);
+
+    // different mask
+    auto part(proto.cloneEmpty());
+    part["i16"] = 5;
+    part["sub.inner.u64"] = 7u;
+    val = xcode(part, nullptr);
+    testOk1(!val["u8"].isMarked(false, false));
+    testEq(val["i16"].as<int32_t>(), 5);
+
+    // a different type falls back to from_wire_valid()
+    {
+        auto other(nt::NTScalar{TypeCode::Int32}.create());
+        other["value"] = 42;
+        std::vector<uint8_t> buf;
+        {
+            VectorOutBuf S(true, buf);
+            to_wire_valid(S, other);
+            buf.resize(buf.size()-S.size());
+        }
+        TypeStore ctxt;
+        auto actual(other.cloneEmpty());
+        FixedBuf S(true, buf);
+        from_wire_valid(S, ctxt, actual, plan);
+        testOk1(S.good() && S.empty());
+        testEq(actual["value"].as<int32_t>(), 42);
+    }
+}
+
+// EncodePlan encodes as to_wire_valid() does
+void testEncodePlan()
+{
+    testDiag("%s", __func__);
+
+    auto val(nt::NTScalar{TypeCode::Float64A, true}.create());
+    val["value"] = shared_array<const double>({1.0, 2.0});
+    val["alarm.severity"] = 2;
+    val["timeStamp"].mark();
+    val["display.units"] = "mm";
+
+    auto desc = Value::Helper::desc(val);
+    BitMask mask({0u, 1u, 2u, 3u, 4u, 5u, 6u, 7u, 8u, 9u}, desc->size()); // not display
+
+    auto encode = [](const std::function<void(Buffer&)>& fn) {
+        std::vector<uint8_t> buf;
+        VectorOutBuf S(true, buf);
+        fn(S);
+        buf.resize(buf.size()-S.size());
+        return buf;
+    };
+
+    for(auto pmask : {(const BitMask*)nullptr, (const BitMask*)&mask}) {
+        EncodePlan plan;
+        plan.reset(desc, pmask);
+
+        auto expect(encode([&val, pmask](Buffer& buf) { to_wire_valid(buf, val, pmask); }));
+        auto actual(encode([&val, &plan](Buffer& buf) { to_wire_valid(buf, val, plan); }));
+
+        testEq(actual, expect);
+
+        TypeStore ctxt;
+        auto out(val.cloneEmpty());
+        FixedBuf S(true, actual);
+        from_wire_valid(S, ctxt, out);
+        testOk1(S.good() && S.empty());
+        testEq(out["timeStamp.userTag"].isMarked(false, false), true);
+        testEq(out["display.units"].as<std::string>(), pmask ? "" : "mm");
+    }
+}
+
 } // namespace
 
 MAIN(testxcode)
 {
-    testPlan(122);
+    testPlan(237);
     testSetup();
     testDeserializeString();
     testSerialize1();
@@ -992,8 +1359,14 @@ MAIN(testxcode)
     testDeserialize3();
     testDecode1();
     testArrayXCode();
+    testArrayXCodeBulk();
+    testArrayAdopt();
+    testArrayReference();
     testXCodeNTScalar();
     testXCodeNTNDArray();
     testEmptyRequest();
+    testIntern();
+    testDecodePlan();
+    testEncodePlan();
     return testDone();
 }